@@ -0,0 +1,248 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        cache.cpp
+ * @brief       Keep the parsed columns of an input file in a binary columnar
+ *              cache file, which is memory-mapped into the columns by later
+ *              runs on that file.
+ */
+
+#include <cstring>
+
+#include "namespaces.h"
+#include "colData.h"
+#include "fileMap.h"
+#include "cache.h"
+#include "errorMsgs.h"
+
+using namespace ColData;
+
+//----------------------------------------------------------------------------//
+//*********************** ColData::ColumnCache Class *************************//
+//----------------------------------------------------------------------------//
+ColumnCache::ColumnCache(const string& cacheFileName) :
+  m_map{cacheFileName} {}
+
+string ColumnCache::getCacheFileName(const string& fileName) {
+    return fileName + ".cdu";
+}
+
+/*
+ * Write the cache of the given input file from its loaded columns, all of
+ * which must have been loaded whole. Return false if it cannot be written, in
+ * which case no cache is left behind.
+ */
+bool ColumnCache::write(const string& fileName, const string& dlm,
+        const Delimitation dataDlmType, const int dataColTotal,
+        const size_t dataRowTotal, const IntV* dataTimestepIVP) {
+    const string cacheFileName{getCacheFileName(fileName)};
+    ofstream oFile{cacheFileName, std::ios::binary | std::ios::trunc};
+    if (!oFile) { return false; }
+
+    auto writeValue = [&oFile](const auto& value) {
+        oFile.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    auto writeString = [&oFile, &writeValue](const string& str) {
+        writeValue(static_cast<uint64_t>(str.length()));
+        oFile.write(str.data(), str.length());
+    };
+    const int timestepColNo{
+        dataTimestepIVP ? dataTimestepIVP->getColNo() : -1
+    };
+    oFile.write(s_magic, sizeof(s_magic));
+    writeValue(static_cast<uint64_t>(std::filesystem::file_size(fileName)));
+    writeValue(findFileTime(fileName));
+    writeString(dlm);
+    writeValue(static_cast<int32_t>(dataDlmType));
+    writeValue(static_cast<int32_t>(dataColTotal));
+    writeValue(static_cast<int32_t>(timestepColNo));
+    writeValue(static_cast<uint64_t>(dataRowTotal));
+    for (int c=0; c<dataColTotal; ++c) {
+        writeString(c == timestepColNo ? dataTimestepIVP->getColName()
+            : DoubleV::getOnePFromCol(c)->getColName());
+    }
+
+    // The arrays follow the table of their offsets, each one aligned
+    uint64_t offset{static_cast<uint64_t>(oFile.tellp())
+        + dataColTotal*sizeof(uint64_t)};
+    for (int c=0; c<dataColTotal; ++c) {
+        offset = (offset + cacheAlignment - 1)/cacheAlignment*cacheAlignment;
+        writeValue(offset);
+        offset += dataRowTotal*(c == timestepColNo ? sizeof(int32_t)
+            : sizeof(double));
+    }
+    const char padding[cacheAlignment]{};
+    auto writeArray = [&oFile, &padding](const auto& data) {
+        oFile.write(padding,
+            (cacheAlignment - oFile.tellp()%cacheAlignment)%cacheAlignment);
+        oFile.write(reinterpret_cast<const char*>(data.data()),
+            data.size()*sizeof(data[0]));
+    };
+    for (int c=0; c<dataColTotal; ++c) {
+        const DoubleV* dVP{
+            c == timestepColNo ? nullptr : DoubleV::getOnePFromCol(c)
+        };
+        if (!dVP) { writeArray(dataTimestepIVP->getData()); }
+        else if (dVP->isFloatStored()) { writeArray(dVP->copyData()); }
+        else { writeArray(dVP->getData()); }
+    }
+    oFile.close();
+    if (!oFile) {
+        std::error_code error;
+        std::filesystem::remove(cacheFileName, error);
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Read the header of the mapped cache. Return false if it is not a complete
+ * cache of the given input file as it is now with the given delimiter.
+ */
+bool ColumnCache::read(const string& fileName, const string& dlm) {
+    const char* pos{m_map.getData()};
+    const char* end{pos + m_map.getSize()};
+    bool valid{true};
+
+    auto readValue = [&pos, end, &valid](auto& value) {
+        if (!valid || static_cast<size_t>(end - pos) < sizeof(value)) {
+            valid = false;
+            return;
+        }
+        std::memcpy(&value, pos, sizeof(value));
+        pos += sizeof(value);
+    };
+    auto readString = [&pos, end, &valid, &readValue](string& str) {
+        uint64_t length{0};
+        readValue(length);
+        if (!valid || static_cast<size_t>(end - pos) < length) {
+            valid = false;
+            return;
+        }
+        str.assign(pos, length);
+        pos += length;
+    };
+    if (m_map.getSize() < sizeof(s_magic)
+            || !std::equal(s_magic, s_magic + sizeof(s_magic), pos)) {
+        return false;
+    }
+    pos += sizeof(s_magic);
+
+    std::error_code error;
+    const size_t fileSize{std::filesystem::file_size(fileName, error)};
+    if (error) { return false; }
+    uint64_t cachedFileSize, dataRowTotal;
+    int64_t cachedFileTime;
+    int32_t dataDlmType, dataColTotal, timestepColNo;
+    string cachedDlm;
+    readValue(cachedFileSize), readValue(cachedFileTime);
+    readString(cachedDlm);
+    readValue(dataDlmType), readValue(dataColTotal), readValue(timestepColNo);
+    readValue(dataRowTotal);
+    if (!valid || cachedFileSize != fileSize
+            || cachedFileTime != findFileTime(fileName) || cachedDlm != dlm
+            || dataColTotal <= 0 || timestepColNo >= dataColTotal) {
+        return false;
+    }
+
+    m_colNames.resize(dataColTotal);
+    m_colOffsets.resize(dataColTotal);
+    for (string& colName : m_colNames) { readString(colName); }
+    for (size_t& colOffset : m_colOffsets) {
+        uint64_t offset{0};
+        readValue(offset);
+        colOffset = offset;
+    }
+    if (!valid) { return false; }
+    for (int c=0; c<dataColTotal; ++c) {
+        const size_t bytes{dataRowTotal*(c == timestepColNo ? sizeof(int32_t)
+            : sizeof(double))};
+        if (m_colOffsets[c] % cacheAlignment != 0
+                || m_colOffsets[c] > m_map.getSize()
+                || m_map.getSize() - m_colOffsets[c] < bytes) {
+            return false;
+        }
+    }
+    m_dataDlmType = static_cast<Delimitation>(dataDlmType);
+    m_dataColTotal = dataColTotal;
+    m_timestepColNo = timestepColNo;
+    m_dataRowTotal = dataRowTotal;
+    return true;
+}
+
+/*
+ * Create the column objects as views of the arrays of the mapped cache, which
+ * is then kept mapped.
+ */
+void ColumnCache::createColumns() {
+    Table& table{Table::getCurrent()};
+    if (m_timestepColNo >= 0) {
+        table.getIntColNoSet().insert(m_timestepColNo);
+    }
+    for (int c=0; c<m_dataColTotal; ++c) {
+        if (c != m_timestepColNo) { table.getDoubleColNoSet().insert(c); }
+    }
+    for (int c=0; c<m_dataColTotal; ++c) {
+        const char* data{m_map.getData() + m_colOffsets[c]};
+        if (c == m_timestepColNo) {
+            new IntV(table, c, m_colNames[c], ColSpan<int>{
+                reinterpret_cast<const int*>(data), m_dataRowTotal});
+        }
+        else {
+            new DoubleV(table, c, m_colNames[c], ColSpan<double>{
+                reinterpret_cast<const double*>(data), m_dataRowTotal});
+        }
+    }
+    s_cacheSetP.push_back(this);
+}
+
+Delimitation ColumnCache::getDataDlmType() const   { return m_dataDlmType; }
+int ColumnCache::getDataColTotal() const            { return m_dataColTotal; }
+size_t ColumnCache::getDataRowTotal() const         { return m_dataRowTotal; }
+
+//----------------------------------------------------------------------------//
+//**************************** Cached data loading ***************************//
+//----------------------------------------------------------------------------//
+/*
+ * Load the columns from the cache of the input file without parsing it. If
+ * the file has no valid cache, it is loaded whole and its cache is written
+ * for the later runs; a cache that cannot be written is skipped. Return the
+ * same variables as ColData::loadData().
+ */
+const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+        ColData::loadCachedData(const string& fileName, const string& dlm,
+            const LoadOptions& loadOptions) {
+    const string cacheFileName{ColumnCache::getCacheFileName(fileName)};
+    std::error_code error;
+    if (std::filesystem::is_regular_file(cacheFileName, error)) {
+        ColumnCache* cacheP{new ColumnCache(cacheFileName)};
+        if (cacheP->read(fileName, dlm)) {
+            cout << "File found. Program initiated." << flush;
+            cout << "\rIn progress: Mapping column cache..." << flush;
+            cacheP->createColumns();
+            cout << '\r' << string(38, ' ') << "\n" << flush;
+
+            IntV* dataTimestepIVP{nullptr};
+            if (!IntV::getSetP().empty()) {
+                dataTimestepIVP = IntV::getOneP(0);
+            }
+            const LoadStats loadStats{std::filesystem::file_size(fileName), 0};
+            return {cacheP->getDataDlmType(), cacheP->getDataColTotal(),
+                    cacheP->getDataRowTotal(), dataTimestepIVP,
+                    DoubleV::getSetP(), loadStats};
+        }
+        delete cacheP;
+    }
+
+    LoadOptions cachedOptions{loadOptions};
+    cachedOptions.cached = false;
+    cachedOptions.projected = false;
+    cachedOptions.windowed = false;
+    const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+        loadedData{loadData(fileName, dlm, cachedOptions)};
+    ColumnCache::write(fileName, dlm, get<0>(loadedData), get<1>(loadedData),
+        get<2>(loadedData), get<3>(loadedData));
+    return loadedData;
+}
@@ -0,0 +1,62 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        cache.h
+ * @brief       Keep the parsed columns of an input file in a binary columnar
+ *              cache file, which is memory-mapped into the columns by later
+ *              runs on that file.
+ */
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include "namespaces.h"
+#include "fileMap.h"
+#include "errorMsgs.h"
+
+//----------------------------------------------------------------------------//
+//*********************** ColData::ColumnCache Class *************************//
+//----------------------------------------------------------------------------//
+/*
+ * Binary columnar cache of an input file, which is kept next to it with the
+ * extension ".cdu". It holds the data delimitation type, the number of rows,
+ * the column names, and the data of each column as a contiguous array that is
+ * aligned to cacheAlignment bytes; the timestep column is kept as integers.
+ * It is valid only for the same delimiter and for an input file of the same
+ * size and time of last modification. A cache whose columns have been created
+ * stays mapped, since the columns are views of it.
+ */
+class ColData::ColumnCache {
+  private:
+    inline static constexpr char        s_magic[4]{'C', 'D', 'U', '1'};
+    inline static vector<ColumnCache*>  s_cacheSetP{};
+    const MappedFile                    m_map;
+    Delimitation                        m_dataDlmType{Delimitation::undefined};
+    int                                 m_dataColTotal{0};
+    int                                 m_timestepColNo{-1};
+    size_t                              m_dataRowTotal{0};
+    vector<string>                      m_colNames{};
+    vector<size_t>                      m_colOffsets{};
+
+    ColumnCache() = delete;
+    ColumnCache(const ColumnCache&) = delete;
+    ColumnCache& operator=(const ColumnCache&) = delete;
+
+  public:
+    explicit ColumnCache(const string& cacheFileName);
+
+    static string getCacheFileName(const string& fileName);
+    static bool write(const string& fileName, const string& dlm,
+        const Delimitation dataDlmType, const int dataColTotal,
+        const size_t dataRowTotal, const IntV* dataTimestepIVP);
+    bool read(const string& fileName, const string& dlm);
+    void createColumns();
+
+    Delimitation getDataDlmType() const;
+    int getDataColTotal() const;
+    size_t getDataRowTotal() const;
+};
+
+#endif
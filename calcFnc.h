@@ -22,12 +22,7 @@ using namespace ColData;
 template<typename T>
 double CalcFnc::findMax(const T column,
         const size_t rowBgn, const size_t rowEnd) {
-    const vector<double> colData{DoubleV::getOnePFromCol(column)->getData()};
-    double maxVal{colData[rowBgn]};
-    for (size_t row=rowBgn+1; row<=rowEnd; ++row) {
-        if (maxVal<colData[row]) { maxVal = colData[row]; }
-    }
-    return maxVal;
+    return DoubleV::getOnePFromCol(column)->getMax(rowBgn, rowEnd);
 }
 
 /*
@@ -37,12 +32,7 @@ double CalcFnc::findMax(const T column,
 template<typename T>
 double CalcFnc::findMin(const T column,
         const size_t rowBgn, const size_t rowEnd) {
-    const vector<double> colData{DoubleV::getOnePFromCol(column)->getData()};
-    double minVal{colData[rowBgn]};
-    for (size_t row=rowBgn+1; row<=rowEnd; ++row) {
-        if (minVal>colData[row]) { minVal = colData[row]; }
-    }
-    return minVal;
+    return DoubleV::getOnePFromCol(column)->getMin(rowBgn, rowEnd);
 }
 
 /*
@@ -52,12 +42,7 @@ double CalcFnc::findMin(const T column,
 template<typename T>
 double CalcFnc::findAbsMax(const T column,
         const size_t rowBgn, const size_t rowEnd) {
-    const vector<double> colData{DoubleV::getOnePFromCol(column)->getData()};
-    double maxVal{std::abs(colData[rowBgn])};
-    for (size_t row=rowBgn+1; row<=rowEnd; ++row) {
-        if (maxVal<std::abs(colData[row])) { maxVal = std::abs(colData[row]); }
-    }
-    return maxVal;
+    return DoubleV::getOnePFromCol(column)->getAbsMax(rowBgn, rowEnd);
 }
 
 /*
@@ -67,12 +52,7 @@ double CalcFnc::findAbsMax(const T column,
 template<typename T>
 double CalcFnc::findAbsMin(const T column,
         const size_t rowBgn, const size_t rowEnd) {
-    const vector<double> colData{DoubleV::getOnePFromCol(column)->getData()};
-    double minVal{std::abs(colData[rowBgn])};
-    for (size_t row=rowBgn+1; row<=rowEnd; ++row) {
-        if (minVal>std::abs(colData[row])) { minVal = std::abs(colData[row]); }
-    }
-    return minVal;
+    return DoubleV::getOnePFromCol(column)->getAbsMin(rowBgn, rowEnd);
 }
 
 /*
@@ -7,6 +7,8 @@
  * @brief       Read command line input options.
  */
 
+#include <glob.h>
+
 #include "namespaces.h"
 #include "cmdArgs.h"
 #include "mappings.h"
@@ -24,10 +26,11 @@ Args::Args(int argc, char* argv[]) :
   m_columnP{nullptr}, m_rowP{nullptr}, m_timestepP{nullptr},
   m_cycleP{nullptr}, m_fourierP{nullptr},
   m_fileOutP{nullptr}, m_printDataP{nullptr}, m_fileDataP{nullptr},
-  m_helpP{nullptr}, m_versionP{nullptr} {
+  m_loaderP{nullptr}, m_helpP{nullptr}, m_versionP{nullptr},
+  m_streamP{nullptr}, m_streamQuery{} {
     if (argc<=1) { throw logic_error(errorNoArguments); }
     for (s_c=1; s_c<m_argc; ++s_c) {
-        if (m_argv[s_c][0] == '-') {
+        if (m_argv[s_c][0] == '-' && m_argv[s_c] != ColData::stdinFileName) {
             unordered_map<string, Option>::const_iterator
                 mapIt{mapStrToOption.find(m_argv[s_c])};
 
@@ -116,6 +119,72 @@ Args::Args(int argc, char* argv[]) :
                             m_fileDataP = new FileData(s_c, m_argc, m_argv);
                         }
                         break;
+                    case Option::mmap:
+                        if (!m_loaderP) {
+                            m_loaderP = new Loader();
+                        }
+                        m_loaderP->setMapped();
+                        break;
+                    case Option::threads:
+                        if (!m_loaderP) {
+                            m_loaderP = new Loader();
+                        }
+                        m_loaderP->setThreads(s_c, m_argc, m_argv);
+                        break;
+                    case Option::stream:
+                        if (!m_loaderP) {
+                            m_loaderP = new Loader();
+                        }
+                        m_loaderP->setStreamed();
+                        break;
+                    case Option::follow:
+                        if (!m_loaderP) {
+                            m_loaderP = new Loader();
+                        }
+                        m_loaderP->setFollowed(s_c, m_argc, m_argv);
+                        break;
+                    case Option::index:
+                        if (!m_loaderP) {
+                            m_loaderP = new Loader();
+                        }
+                        m_loaderP->setIndexed();
+                        break;
+                    case Option::cache:
+                        if (!m_loaderP) {
+                            m_loaderP = new Loader();
+                        }
+                        m_loaderP->setCached();
+                        break;
+                    case Option::precision:
+                        if (!m_loaderP) {
+                            m_loaderP = new Loader();
+                        }
+                        m_loaderP->setPrecision(s_c, m_argc, m_argv);
+                        break;
+                    case Option::lazy:
+                        if (!m_loaderP) {
+                            m_loaderP = new Loader();
+                        }
+                        m_loaderP->setLazy();
+                        break;
+                    case Option::readAhead:
+                        if (!m_loaderP) {
+                            m_loaderP = new Loader();
+                        }
+                        m_loaderP->setReadAhead(s_c, m_argc, m_argv);
+                        break;
+                    case Option::hugePages:
+                        if (!m_loaderP) {
+                            m_loaderP = new Loader();
+                        }
+                        m_loaderP->setHugePages();
+                        break;
+                    case Option::prefixSums:
+                        if (!m_loaderP) {
+                            m_loaderP = new Loader();
+                        }
+                        m_loaderP->setPrefixSums();
+                        break;
                     case Option::help:
                         if (!m_helpP) {
                             m_helpP = new Help();
@@ -160,17 +229,51 @@ void Args::process() {
     }
     if (!m_rowP) { m_rowP = new Row(); }
     if (!m_timestepP) { m_timestepP = new Timestep(); }
+    if (!m_loaderP) { m_loaderP = new Loader(); }
+    m_loaderP->selectColumns(m_columnP, m_cycleP, m_fourierP);
+    m_loaderP->selectRows(m_rowP, m_timestepP, m_cycleP);
+    const vector<string>& fileLocSet{m_fileInP->getFileLocSet()};
+    if (fileLocSet.size() > 1 && (m_loaderP->getLoadOptions().streamed
+            || m_loaderP->getLoadOptions().indexed
+            || m_loaderP->getLoadOptions().cached
+            || std::count(fileLocSet.cbegin(), fileLocSet.cend(),
+                ColData::stdinFileName))) {
+        throw logic_error(errorMergeUnsupported);
+    }
+    if (m_fileInP->getFileLocation() == ColData::stdinFileName
+            && (m_loaderP->getLoadOptions().streamed
+                || m_loaderP->getLoadOptions().indexed
+                || m_loaderP->getLoadOptions().cached)) {
+        throw logic_error(errorStdinUnsupported);
+    }
+    if (m_loaderP->getLoadOptions().streamed) {
+        processStream();
+        return;
+    }
 
     // Load file and save the returned parameters ----------------------------//
-    tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&> loadedFileData {
+    tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+            loadedFileData {
+        (fileLocSet.size() > 1) ?
+        ColData::loadMergedData(fileLocSet, m_delimiterP->getDelimiter(),
+            m_loaderP->getLoadOptions()) :
         ColData::loadData(m_fileInP->getFileLocation(),
-        m_delimiterP->getDelimiter())
+            m_delimiterP->getDelimiter(), m_loaderP->getLoadOptions())
     };
     m_fileInP->importDataDlmType(get<0>(loadedFileData));
+    m_fileInP->importLoadStats(get<5>(loadedFileData));
     m_columnP->importDataColTotal(get<1>(loadedFileData));
     m_columnP->importDataDouble(get<4>(loadedFileData));
     m_rowP->importDataRowTotal(get<2>(loadedFileData));
-    m_timestepP->importDataTimestep(get<3>(loadedFileData));
+    m_rowP->importDataRowWindow(get<5>(loadedFileData).rowOffset,
+        get<5>(loadedFileData).partial);
+    if (get<5>(loadedFileData).windowed) {
+        m_timestepP->importDataTimestep(get<3>(loadedFileData),
+            get<5>(loadedFileData).timestepRange);
+    }
+    else {
+        m_timestepP->importDataTimestep(get<3>(loadedFileData));
+    }
 
     // After loading file ----------------------------------------------------//
     // Mandatory argument members
@@ -258,14 +361,14 @@ void Args::process() {
                 m_columnP->getDataDoubleVSetP(),
                 m_cycleP->getCycleColNo(),
                 m_rowP->getRowBgn(), m_rowP->getRowEnd(),
-                m_fileInP->getFileLocation()
+                m_fileInP->getFileLocation(), m_rowP->getDataRowOffset()
             );
         }
         else {
             m_fourierP->process(
                 m_columnP->getDataDoubleVSetP(), -1,
                 m_rowP->getRowBgn(), m_rowP->getRowEnd(),
-                m_fileInP->getFileLocation()
+                m_fileInP->getFileLocation(), m_rowP->getDataRowOffset()
             );
         }
     }
@@ -278,6 +381,157 @@ void Args::process() {
     if (m_fileDataP) { m_fileDataP->process(m_fileInP->getFileLocation()); }
 }
 
+/*
+ * Process the arguments for the --stream option. The header is read first, so
+ * that the columns, rows, timesteps and cycles can be resolved before the data
+ * is streamed; the rows and timesteps are checked against the data afterwards.
+ * The total number of rows and the timestep range are not known before the
+ * data is streamed, so they are taken to be unlimited until then.
+ */
+void Args::processStream() {
+    if (m_fourierP || m_printDataP || m_fileDataP) {
+        throw logic_error(errorStreamUnsupported);
+    }
+    if (ColData::findCompression(m_fileInP->getFileLocation())
+            != ColData::Compression::none) {
+        throw logic_error(errorStreamCompressed);
+    }
+
+    // Read the header -------------------------------------------------------//
+    m_streamP = new ColData::DataStream(m_fileInP->getFileLocation(),
+        m_delimiterP->getDelimiter(), m_loaderP->getLoadOptions());
+    IntV* dataTimestepIVP{m_streamP->getDataTimestepIVP()};
+    m_fileInP->importDataDlmType(m_streamP->getDataDlmType());
+    m_fileInP->importLoadStats(m_streamP->getLoadStats());
+    m_columnP->importDataColTotal(m_streamP->getDataColTotal());
+    m_columnP->importDataDouble(DoubleV::getSetP());
+    m_rowP->importDataRowTotal(numeric_limits<size_t>::max());
+    if (dataTimestepIVP) {
+        m_timestepP->importDataTimestep(dataTimestepIVP,
+            {true, 0, numeric_limits<size_t>::max()});
+    }
+
+    // Resolve the query -----------------------------------------------------//
+    ColData::StreamQuery& query{m_streamQuery};
+    if (m_cycleP) {
+        m_cycleP->process(m_columnP->getDataDoubleVSetP());
+        if (m_cycleP->getInitType() == CmdArgs::CycleInit::last) {
+            throw logic_error(errorStreamCycleLast);
+        }
+        m_rowP->process(
+            get<0>(m_cycleP->getRowDefStatus()),
+            get<1>(m_cycleP->getRowDefStatus()),
+            get<0>(m_cycleP->getRowDefRange()),
+            get<1>(m_cycleP->getRowDefRange()),
+            m_cycleP->getInitType()
+        );
+        m_timestepP->process(
+            get<0>(m_cycleP->getTimestepDefStatus()),
+            get<1>(m_cycleP->getTimestepDefStatus()),
+            get<0>(m_cycleP->getTimestepDefRange()),
+            get<1>(m_cycleP->getTimestepDefRange()),
+            m_cycleP->getInitType(),
+            m_cycleP->getTimeIncrement()
+        );
+        query.cycleColNo = m_cycleP->getCycleColNo();
+        query.cycles = (m_cycleP->getInitType() == CmdArgs::CycleInit::first) ?
+            m_cycleP->getInputCount() : -1;
+        query.center = m_cycleP->getCenter();
+        query.minAmplitude = m_cycleP->getMinAmplitude();
+        query.minRowInterval = m_cycleP->getMinRowInterval();
+        query.simTimeColNo = m_cycleP->getSimTimeColNo();
+    }
+    else {
+        m_rowP->process();
+        m_timestepP->process();
+    }
+    tie(query.rowBgnDefined, query.rowEndDefined) = m_rowP->getDefStatus();
+    tie(query.rowBgn, query.rowEnd) = m_rowP->getRange();
+    tie(query.timestepBgnDefined, query.timestepEndDefined) =
+        m_timestepP->getDefStatus();
+    tie(query.timestepBgn, query.timestepEnd) = m_timestepP->getRange();
+    if ((query.rowBgnDefined && query.timestepBgnDefined)
+            || (query.rowEndDefined && query.timestepEndDefined)) {
+        throw logic_error(errorRowTimestepConflict);
+    }
+
+    // Stream the data and check the query against it ------------------------//
+    importStreamResult(m_streamP->run(query));
+    if (m_calcP) { m_calcP->process(); }
+    m_columnP->process(dataTimestepIVP);
+
+    // Optional argument members
+    if (m_fileOutP) { m_fileOutP->process(m_fileInP->getFileLocation()); }
+}
+
+/*
+ * Check the query against the result of streaming the data, and take the total
+ * number of rows, the timestep range, the ranges of rows and timesteps and the
+ * cycle data from it.
+ */
+void Args::importStreamResult(const ColData::StreamResult& result) {
+    const ColData::IntV* dataTimestepIVP{m_streamP->getDataTimestepIVP()};
+    m_rowP->importDataRowTotal(result.dataRowTotal);
+    m_rowP->process();
+    if (dataTimestepIVP) {
+        m_timestepP->importDataTimestep(dataTimestepIVP, result.timestepRange);
+    }
+    if (m_cycleP && !get<0>(result.timestepRange)
+            && m_cycleP->getTimeIncrement() >= 0.0) {
+        throw logic_error(errorDataTimestepInconsistent);
+    }
+    m_timestepP->process();
+    if (!result.rowRangeFound) {
+        throw invalid_argument(errorRowRangeInvalid);
+    }
+    m_rowP->setRowBgn(result.rowBgn);
+    m_rowP->setRowEnd(result.rowEnd);
+    if (m_timestepP->isTimestepConsistent()) {
+        m_timestepP->setTimestepBgn(result.timestepBgn);
+        m_timestepP->setTimestepEnd(result.timestepEnd);
+    }
+    if (m_cycleP) {
+        if (!result.cycleInitialFound) {
+            throw runtime_error(errorDataInvalid);
+        }
+        if (m_streamQuery.cycles >= 0
+                && result.cycleData.cycleCount != m_streamQuery.cycles) {
+            throw invalid_argument(errorCycleNotAvailable);
+        }
+        m_cycleP->setCalcCDataAndCycleInputCount(result.cycleData);
+        if (m_cycleP->getSimTimeColNo()>=0) {
+            m_cycleP->setFrequencyFromSimTime(result.simTimeBgn,
+                result.simTimeEnd);
+        }
+        else if(m_cycleP->getTimeIncrement()>=0.0) {
+            m_cycleP->setFrequency(m_timestepP->getRange());
+        }
+        if (m_cycleP->getFileName() == "auto") {
+            m_cycleP->setAutoFileName(m_rowP->getRowBgn(), m_rowP->getRowEnd(),
+                m_fileInP->getFileLocation());
+        }
+    }
+}
+
+/*
+ * Wait for lines to be appended to the followed input file, checking its size
+ * at the interval of the --follow option, and stream only the new lines into
+ * the accumulators, whose result is then imported again. Return false if the
+ * input file is not followed.
+ */
+bool Args::follow() {
+    if (!m_streamP || !m_loaderP->getLoadOptions().followed) { return false; }
+    const std::chrono::seconds interval{
+        m_loaderP->getLoadOptions().followSeconds
+    };
+    do {
+        std::this_thread::sleep_for(interval);
+    } while (!m_streamP->resume());
+    m_fileInP->importLoadStats(m_streamP->getLoadStats());
+    importStreamResult(m_streamP->getResult());
+    return true;
+}
+
 int Args::setCount(int newCount)                { return(s_c = newCount); }
 int Args::getCount()                            { return s_c; }
 int Args::getArgC() const                       { return m_argc; }
@@ -295,6 +549,7 @@ const Fourier* Args::getFourierP() const        { return m_fourierP; }
 const FileOut* Args::getFileOutP() const        { return m_fileOutP; }
 const PrintData* Args::getPrintDataP() const    { return m_printDataP; }
 const FileData* Args::getFileDataP() const      { return m_fileDataP; }
+const Loader* Args::getLoaderP() const          { return m_loaderP; }
 const Help* Args::getHelpP() const              { return m_helpP; }
 const Version* Args::getVersionP() const        { return m_versionP; }
 
@@ -357,21 +612,53 @@ const string& Delimiter::getDelimiter() const { return m_delimiter; }
 //----------------------------------------------------------------------------//
 
 FileIn::FileIn(int c, int argC, const vector<string>& argV) {
-    if (c+1 < argC && argV[c+1][0] != '-') {
-        m_fileLocation = argV[Args::setCount(++c)];
+    if (c+1 < argC && (argV[c+1][0] != '-'
+            || argV[c+1] == ColData::stdinFileName)) {
+        addFileLocations(argV[Args::setCount(++c)]);
     }
     else { throw invalid_argument(errorFileInNameMissing); }
+    while (c+1 < argC && argV[c+1][0] != '-') {
+        addFileLocations(argV[Args::setCount(++c)]);
+    }
 }
 FileIn::FileIn(const vector<string>& argV) {
-    m_fileLocation = argV[Args::setCount(1)];
+    int c{Args::setCount(1)};
+    addFileLocations(argV[c]);
+    while (c+1 < static_cast<int>(argV.size()) && argV[c+1][0] != '-') {
+        addFileLocations(argV[Args::setCount(++c)]);
+    }
+}
+
+/*
+ * Add the given file, or the files matched by it in the order of their names
+ * if it is a wildcard pattern that matches any. The first file names the input
+ * for the output files.
+ */
+void FileIn::addFileLocations(const string& fileLocation) {
+    glob_t matches{};
+    if (fileLocation.find_first_of("*?[") != string::npos
+            && glob(fileLocation.c_str(), 0, nullptr, &matches) == 0) {
+        m_fileLocSet.insert(m_fileLocSet.end(), matches.gl_pathv,
+            matches.gl_pathv + matches.gl_pathc);
+    }
+    else {
+        m_fileLocSet.push_back(fileLocation);
+    }
+    globfree(&matches);
+    m_fileLocation = m_fileLocSet.front();
 }
 
 void FileIn::importDataDlmType(Delimitation dataDlmType) {
     m_dataDlmType = dataDlmType;
 }
+void FileIn::importLoadStats(const ColData::LoadStats& loadStats) {
+    m_loadStats = loadStats;
+}
 
 const string& FileIn::getFileLocation() const   { return m_fileLocation; }
+const vector<string>& FileIn::getFileLocSet() const { return m_fileLocSet; }
 Delimitation FileIn::getDataDlmType() const     { return m_dataDlmType; }
+const ColData::LoadStats& FileIn::getLoadStats() const { return m_loadStats; }
 
 //----------------------------------------------------------------------------//
 //****************************** CmdArgs::Calc *******************************//
@@ -534,6 +821,10 @@ void Row::setRowEnd(int c, int argC, const vector<string>& argV) {
 void Row::importDataRowTotal(size_t dataRowTotal) {
     m_dataRowTotal = dataRowTotal;
 }
+void Row::importDataRowWindow(size_t dataRowOffset, bool dataPartial) {
+    m_dataRowOffset = dataRowOffset;
+    m_dataPartial = dataPartial;
+}
 void Row::process(bool rowDefined1, bool rowDefined2, size_t row1, size_t row2,
         CycleInit cycleInitStatus){
     if (rowDefined1 && rowDefined2) {
@@ -553,27 +844,37 @@ void Row::process(bool rowDefined1, bool rowDefined2, size_t row1, size_t row2,
     }
     Row::process();
 }
+/*
+ * Check the rows against the loaded data. If only a window of the rows has been
+ * loaded, the rows are checked against the end of the file only if the window
+ * reaches it, and they are then made relative to the window.
+ */
 void Row::process() {
     if (m_rowBgnDefined && m_rowEndDefined && m_rowBgn > m_rowEnd) {
         size_t temp = m_rowBgn;
         m_rowBgn = m_rowEnd;
         m_rowEnd = temp;
     }
+    const size_t dataRowLast{m_dataRowOffset + m_dataRowTotal - 1};
     if (m_rowBgnDefined) {
-        if (m_rowBgn >= (m_dataRowTotal - 1)) {
+        if (m_rowBgn < m_dataRowOffset
+                || (!m_dataPartial && m_rowBgn >= dataRowLast)) {
             throw invalid_argument(errorRowRangeInvalid);
         }
+        m_rowBgn -= m_dataRowOffset;
     }
     if (m_rowEndDefined) {
-        if (m_rowEnd > (m_dataRowTotal - 1)) {
+        if (m_rowEnd < m_dataRowOffset || m_rowEnd > dataRowLast) {
             throw invalid_argument(errorRowRangeInvalid);
         }
+        m_rowEnd -= m_dataRowOffset;
     }
 }
 void Row::setRowBgn(size_t val) { m_rowBgn = val; }
 void Row::setRowEnd(size_t val) { m_rowEnd = val; }
 void Row::setRowEndFromData() { m_rowEnd = m_dataRowTotal - 1; }
 size_t Row::getDataRowTotal() const { return m_dataRowTotal; }
+size_t Row::getDataRowOffset() const { return m_dataRowOffset; }
 tuple<size_t, size_t> Row::getRange() const { return {m_rowBgn, m_rowEnd}; }
 size_t Row::getRowBgn() const { return m_rowBgn; }
 size_t Row::getRowEnd() const { return m_rowEnd; }
@@ -634,6 +935,12 @@ void Timestep::importDataTimestep(const ColData::IntV* dataTimestepIVP) {
         m_dataTimestepRange = dataTimestepIVP->getTimestepRange();
     }
 }
+void Timestep::importDataTimestep(const ColData::IntV* dataTimestepIVP,
+        tuple<bool, size_t, size_t> dataTimestepRange) {
+    m_dataTimestepIVP = dataTimestepIVP;
+    m_dataTimestepRange = dataTimestepRange;
+    m_timestepConsistent = false;
+}
 void Timestep::process(bool timestepDefined1, bool timestepDefined2,
         size_t timestep1, size_t timestep2, CycleInit cycleInitStatus,
         double timeIncrement) {
@@ -934,16 +1241,39 @@ void Cycle::process(const vector<ColData::DoubleV*>& dataDoubleVSetP) {
         throw logic_error(errorFrequencyTooManyArguments);
     }
 }
+/*
+ * Find the arguments that may give a column before the file is loaded: the
+ * values of "c=" and "st=", and the other arguments that are neither numbers
+ * nor keyword values. Those that are not columns are ignored by the loader.
+ */
+vector<string> Cycle::getColInputs() const {
+    vector<string> colInputs{};
+    size_t pos;
+    for (const string& cycleArg : m_argV) {
+        if ((pos=cycleArg.find("st=")) != string::npos) {
+            colInputs.push_back(cycleArg.substr(pos+3));
+        }
+        else if ((pos=cycleArg.find("c=")) != string::npos) {
+            colInputs.push_back(cycleArg.substr(pos+2));
+        }
+        else if (cycleArg.find('=') == string::npos
+                && !all_of(cycleArg.begin(), cycleArg.end(), isdigit)) {
+            colInputs.push_back(cycleArg);
+        }
+    }
+    return colInputs;
+}
 void Cycle::setCalcCDataAndCycleInputCount(ColData::CycleData cData) {
     m_calcCycleData = cData;
     m_cycleInputCount = cData.cycleCount;
 }
 void Cycle::setFrequency(size_t rowBgn, size_t rowEnd) {
-    vector<double> simTimeColData{
-        DoubleV::getOnePFromCol(m_simTimeColNo)->getData()
-    };
+    const DoubleV* simTimeColDVP{DoubleV::getOnePFromCol(m_simTimeColNo)};
     m_frequency = m_cycleInputCount /
-        (simTimeColData[rowEnd] - simTimeColData[rowBgn]);
+        (simTimeColDVP->getValue(rowEnd) - simTimeColDVP->getValue(rowBgn));
+}
+void Cycle::setFrequencyFromSimTime(double simTimeBgn, double simTimeEnd) {
+    m_frequency = m_cycleInputCount / (simTimeEnd - simTimeBgn);
 }
 void Cycle::setFrequency(tuple <size_t, size_t> timestepRange) {
     m_frequency = m_cycleInputCount /
@@ -1008,7 +1338,7 @@ void Fourier::init(int c, int argC, const vector<string>& argV) {
 
 void Fourier::process(const vector<ColData::DoubleV*>& dataDoubleVSetP,
         const int colNo, const size_t rowBgn, const size_t rowEnd,
-        const string& fileInName) {
+        const string& fileInName, const size_t rowOffset) {
     if (colNo>=0) {
         m_colNo = colNo;
     }
@@ -1070,8 +1400,8 @@ void Fourier::process(const vector<ColData::DoubleV*>& dataDoubleVSetP,
     }
     if (m_fileName == "auto") {
         string fileNameAffix{
-            "_fft_c" + to_string(m_colNo) + "_r" + to_string(rowBgn) + "to"
-            + to_string(rowEnd) + ".csv"
+            "_fft_c" + to_string(m_colNo) + "_r" + to_string(rowOffset + rowBgn)
+            + "to" + to_string(rowOffset + rowEnd) + ".csv"
         };
         if ((pos = fileInName.find_last_of('.')) != string::npos
                 && (fileInName.size() - pos) < 5) {
@@ -1082,6 +1412,23 @@ void Fourier::process(const vector<ColData::DoubleV*>& dataDoubleVSetP,
         }
     }
 }
+/*
+ * Find the arguments that may give a column before the file is loaded, in the
+ * same way as Cycle::getColInputs().
+ */
+vector<string> Fourier::getColInputs() const {
+    vector<string> colInputs{};
+    size_t pos;
+    for (const string& fourierArg : m_argV) {
+        if ((pos=fourierArg.find("c=")) != string::npos) {
+            colInputs.push_back(fourierArg.substr(pos+2));
+        }
+        else if (fourierArg.find('=') == string::npos) {
+            colInputs.push_back(fourierArg);
+        }
+    }
+    return colInputs;
+}
 int Fourier::getColNo() const { return m_colNo; }
 const tuple<size_t, size_t> Fourier::getRowRange() const {
     return m_rowRange;
@@ -1156,6 +1503,149 @@ void FileData::process(const string& fileInName) {
 const string& FileData::getFileName() const { return m_fileDataName; }
 const string FileData::getDelimiter() const { return m_delimiter; }
 
+//----------------------------------------------------------------------------//
+//***************************** CmdArgs::Loader ******************************//
+//----------------------------------------------------------------------------//
+
+void Loader::setMapped() { m_loadOptions.mapped = true; }
+void Loader::setStreamed() { m_loadOptions.streamed = true; }
+void Loader::setIndexed() { m_loadOptions.indexed = true; }
+void Loader::setCached() { m_loadOptions.cached = true; }
+void Loader::setHugePages() { m_loadOptions.hugePages = true; }
+void Loader::setPrefixSums() { m_loadOptions.prefixSums = true; }
+/*
+ * Decode each data column from the memory-mapped file when it is first used,
+ * instead of parsing every column up front, so this implies --mmap.
+ */
+void Loader::setLazy() {
+    m_loadOptions.mapped = true;
+    m_loadOptions.lazy = true;
+}
+/*
+ * Follow the input file as it grows, checking its size every given number of
+ * seconds, or every second. The file is streamed, so this implies --stream.
+ */
+void Loader::setFollowed(int c, int argC, const vector<string>& argV) {
+    m_loadOptions.streamed = true;
+    m_loadOptions.followed = true;
+    if (c+1 < argC && argV[c+1][0] != '-') {
+        const string& inputStr{argV[Args::setCount(++c)]};
+        if (inputStr.empty() || !all_of(inputStr.begin(), inputStr.end(),
+                isdigit) || stoi(inputStr) <= 0) {
+            throw invalid_argument(errorFollowIntervalInvalid);
+        }
+        m_loadOptions.followSeconds = stoi(inputStr);
+    }
+}
+void Loader::setThreads(int c, int argC, const vector<string>& argV) {
+    m_loadOptions.mapped = true;
+    if (c+1 < argC && argV[c+1][0] != '-') {
+        const string& inputStr{argV[Args::setCount(++c)]};
+        if (inputStr.empty() || inputStr.length() > 4
+                || !all_of(inputStr.begin(), inputStr.end(), isdigit)
+                || stoi(inputStr) <= 0) {
+            throw invalid_argument(errorThreadsInvalid);
+        }
+        m_loadOptions.threads = std::min(
+            static_cast<unsigned>(stoi(inputStr)), ColData::maxThreads);
+    }
+    else {
+        m_loadOptions.threads =
+            std::max(std::thread::hardware_concurrency(), 1u);
+    }
+}
+/*
+ * Read the input file on a separate thread in blocks of the given number of
+ * megabytes, or of readAheadBlockBytes, while the blocks before them are
+ * parsed. This replaces the default loader only, not --mmap or --index.
+ */
+void Loader::setReadAhead(int c, int argC, const vector<string>& argV) {
+    m_loadOptions.readAheadBytes = ColData::readAheadBlockBytes;
+    if (c+1 < argC && argV[c+1][0] != '-') {
+        const string& inputStr{argV[Args::setCount(++c)]};
+        if (inputStr.empty() || inputStr.length() > 4
+                || !all_of(inputStr.begin(), inputStr.end(), isdigit)
+                || stoi(inputStr) <= 0) {
+            throw invalid_argument(errorReadAheadInvalid);
+        }
+        m_loadOptions.readAheadBytes = static_cast<size_t>(stoi(inputStr))
+            << 20;
+    }
+}
+/*
+ * Store the data columns as float or as double, which is the default.
+ */
+void Loader::setPrecision(int c, int argC, const vector<string>& argV) {
+    if (c+1 >= argC) { throw invalid_argument(errorPrecisionInvalid); }
+    const string& inputStr{argV[Args::setCount(++c)]};
+    if (inputStr == "float")        { m_loadOptions.floatStored = true; }
+    else if (inputStr == "double")  { m_loadOptions.floatStored = false; }
+    else { throw invalid_argument(errorPrecisionInvalid); }
+}
+/*
+ * Push the column selection down to the loader, so that only the given columns
+ * and the columns of the cycles and the FFT are converted and stored. All the
+ * columns are loaded if no column is given.
+ */
+void Loader::selectColumns(const Column* columnP, const Cycle* cycleP,
+        const Fourier* fourierP) {
+    if (columnP->getIntInputColSet().empty()
+            && columnP->getStrInputColSet().empty()) {
+        return;
+    }
+    m_loadOptions.projected = true;
+    m_loadOptions.colNos.insert(columnP->getIntInputColSet().cbegin(),
+        columnP->getIntInputColSet().cend());
+    m_loadOptions.colNames.insert(columnP->getStrInputColSet().cbegin(),
+        columnP->getStrInputColSet().cend());
+
+    vector<string> colInputs{};
+    if (cycleP) { colInputs = cycleP->getColInputs(); }
+    if (fourierP) {
+        const vector<string> fourierColInputs{fourierP->getColInputs()};
+        colInputs.insert(colInputs.end(), fourierColInputs.cbegin(),
+            fourierColInputs.cend());
+    }
+    for (const string& colInput : colInputs) {
+        if (!colInput.empty()
+                && all_of(colInput.begin(), colInput.end(), isdigit)) {
+            m_loadOptions.colNos.insert(stoi(colInput));
+        }
+        else {
+            m_loadOptions.colNames.insert(colInput);
+        }
+    }
+}
+/*
+ * Push the range of rows or timesteps down to the loader, which then parses
+ * only the rows of that window and stops at its end. The window is found in
+ * the memory-mapped file, so this implies --mmap. The cycles and the streamed
+ * mode find their own ranges, and the range is loaded whole if rows and
+ * timesteps are both given.
+ */
+void Loader::selectRows(const Row* rowP, const Timestep* timestepP,
+        const Cycle* cycleP) {
+    bool rBgnDef, rEndDef, tBgnDef, tEndDef;
+    tie(rBgnDef, rEndDef) = rowP->getDefStatus();
+    tie(tBgnDef, tEndDef) = timestepP->getDefStatus();
+    if (cycleP || m_loadOptions.streamed || ((rBgnDef || rEndDef)
+            == (tBgnDef || tEndDef))) {
+        return;
+    }
+    m_loadOptions.mapped = true;
+    m_loadOptions.windowed = true;
+    m_loadOptions.rowBgnDefined = rBgnDef;
+    m_loadOptions.rowEndDefined = rEndDef;
+    tie(m_loadOptions.rowBgn, m_loadOptions.rowEnd) = rowP->getRange();
+    m_loadOptions.timestepBgnDefined = tBgnDef;
+    m_loadOptions.timestepEndDefined = tEndDef;
+    tie(m_loadOptions.timestepBgn, m_loadOptions.timestepEnd) =
+        timestepP->getRange();
+}
+const ColData::LoadOptions& Loader::getLoadOptions() const {
+    return m_loadOptions;
+}
+
 //----------------------------------------------------------------------------//
 //****************************** CmdArgs::Help *******************************//
 //----------------------------------------------------------------------------//
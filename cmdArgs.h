@@ -12,6 +12,7 @@
 
 #include "namespaces.h"
 #include "colData.h"
+#include "stream.h"
 #include "calcFnc.h"
 #include "errorMsgs.h"
 
@@ -36,8 +37,11 @@ class CmdArgs::Args {
     FileOut*                m_fileOutP;     // file where to save calculations
     PrintData*              m_printDataP;   // print data to the screen
     FileData*               m_fileDataP;    // file data to a file
+    Loader*                 m_loaderP;      // settings for loading the file
     Help*                   m_helpP;        // help
     Version*                m_versionP;     // version information
+    ColData::DataStream*    m_streamP;      // streamed input file
+    ColData::StreamQuery    m_streamQuery;  // rows and cycles to be streamed
 
     Args() = delete;
     Args(const Args&) = delete;
@@ -46,6 +50,9 @@ class CmdArgs::Args {
   public:
     explicit Args(int argc, char* argv[]);
     void process();
+    void processStream();
+    void importStreamResult(const ColData::StreamResult& result);
+    bool follow();
 
     static int setCount(int newCount);
     static int getCount();
@@ -65,6 +72,7 @@ class CmdArgs::Args {
     const FileOut* getFileOutP() const;
     const PrintData* getPrintDataP() const;
     const FileData* getFileDataP() const;
+    const Loader* getLoaderP() const;
     const Help* getHelpP() const;
     const Version* getVersionP() const;
 
@@ -95,21 +103,28 @@ class CmdArgs::Delimiter {
 
 class CmdArgs::FileIn {
   private:
-    string          m_fileLocation{""};
-    Delimitation    m_dataDlmType{Delimitation::undefined};
+    string              m_fileLocation{""};
+    vector<string>      m_fileLocSet{};     // files to be merged, if several
+    Delimitation        m_dataDlmType{Delimitation::undefined};
+    ColData::LoadStats  m_loadStats{0, 0};
 
     FileIn() = delete;
     FileIn(const FileIn&) = delete;
     FileIn& operator=(const FileIn&) = delete;
 
+    void addFileLocations(const string& fileLocation);
+
   public:
     explicit FileIn(int c, int argC, const vector<string>& argV);
     explicit FileIn(const vector<string>& argV);
 
     void importDataDlmType(Delimitation dataDlmType);
+    void importLoadStats(const ColData::LoadStats& loadStats);
 
     const string& getFileLocation() const;
+    const vector<string>& getFileLocSet() const;
     Delimitation getDataDlmType() const;
+    const ColData::LoadStats& getLoadStats() const;
 };
 
 //----------------------------------------------------------------------------//
@@ -177,6 +192,8 @@ class CmdArgs::Row {
     size_t  m_rowBgn{0};
     size_t  m_rowEnd{0};
     size_t  m_dataRowTotal{0};
+    size_t  m_dataRowOffset{0};     // first row of a window of loaded rows
+    bool    m_dataPartial{false};   // more rows follow the loaded rows
 
     Row(const Row&) = delete;
     Row& operator=(const Row&) = delete;
@@ -187,6 +204,7 @@ class CmdArgs::Row {
     void setRowEnd(int c, int argC, const vector<string>& argV);
 
     void importDataRowTotal(size_t dataRowTotal);
+    void importDataRowWindow(size_t dataRowOffset, bool dataPartial);
     void process(bool rowDefined1, bool rowDefined2,
         size_t row1, size_t row2, CycleInit cycleInitStatus);
     void process();
@@ -195,6 +213,7 @@ class CmdArgs::Row {
     void setRowEnd(size_t val);
     void setRowEndFromData();
     size_t getDataRowTotal() const;
+    size_t getDataRowOffset() const;
     tuple<size_t, size_t> getRange() const;
     size_t getRowBgn() const;
     size_t getRowEnd() const;
@@ -224,6 +243,8 @@ class CmdArgs::Timestep {
     void setTimestepEnd(int c, int argC, const vector<string>& argV);
 
     void importDataTimestep(const ColData::IntV* dataTimestepIVP);
+    void importDataTimestep(const ColData::IntV* dataTimestepIVP,
+        tuple<bool, size_t, size_t> dataTimestepRange);
     void process(bool timestepDefined1, bool timestepDefined2,
         size_t timestep1, size_t timestep2, CycleInit cycleInitStatus,
         double timeIncrement);
@@ -284,9 +305,11 @@ class CmdArgs::Cycle {
     void setCalcCDataAndCycleInputCount(ColData::CycleData);
     void setFrequency(size_t rowBgn, size_t rowEnd);
     void setFrequency(tuple <size_t, size_t> timestepRange);
+    void setFrequencyFromSimTime(double simTimeBgn, double simTimeEnd);
     void setAutoFileName(const size_t rowBgn, const size_t rowEnd,
         const string& fileInName);
 
+    vector<string> getColInputs() const;
     int getInputCount() const;
     CycleInit getInitType() const;
     int getCycleColNo() const;
@@ -327,8 +350,9 @@ class CmdArgs::Fourier {
 
     void process(const vector<ColData::DoubleV*>& dataDoubleVSetP,
         const int colNo, const size_t rowBgn, const size_t rowEnd,
-        const string& fileInName);
+        const string& fileInName, const size_t rowOffset);
 
+    vector<string> getColInputs() const;
     int getColNo() const;
     const tuple<size_t, size_t> getRowRange() const;
     const string& getFileName() const;
@@ -391,6 +415,37 @@ class CmdArgs::FileData {
     const string getDelimiter() const;
 };
 
+//----------------------------------------------------------------------------//
+//***************************** CmdArgs::Loader ******************************//
+//----------------------------------------------------------------------------//
+
+class CmdArgs::Loader {
+  private:
+    ColData::LoadOptions    m_loadOptions{};
+
+    Loader(const Loader&) = delete;
+    Loader& operator=(const Loader&) = delete;
+
+  public:
+    explicit Loader() = default;
+    void setMapped();
+    void setStreamed();
+    void setIndexed();
+    void setCached();
+    void setLazy();
+    void setHugePages();
+    void setPrefixSums();
+    void setFollowed(int c, int argC, const vector<string>& argV);
+    void setThreads(int c, int argC, const vector<string>& argV);
+    void setPrecision(int c, int argC, const vector<string>& argV);
+    void setReadAhead(int c, int argC, const vector<string>& argV);
+    void selectColumns(const Column* columnP, const Cycle* cycleP,
+        const Fourier* fourierP);
+    void selectRows(const Row* rowP, const Timestep* timestepP,
+        const Cycle* cycleP);
+    const ColData::LoadOptions& getLoadOptions() const;
+};
+
 //----------------------------------------------------------------------------//
 //****************************** CmdArgs::Help *******************************//
 //----------------------------------------------------------------------------//
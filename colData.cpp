@@ -8,14 +8,24 @@
  *              correctly.
  */
 
+#include <cstring>
+#include <sys/mman.h>
+
 #include "namespaces.h"
 #include "colData.h"
+#include "tokenizer.h"
+#include "scanner.h"
+#include "index.h"
+#include "lazy.h"
 #include "calcFnc.h"
 #include "mappings.h"
 #include "errorMsgs.h"
 
 using namespace ColData;
 
+// Bytes read from the input file by readLine() during the current load
+static size_t s_bytesScanned{0};
+
 CycleData ColData::calculateCycleData(const vector<double>& crests,
         const vector<double>& troughs, vector<double>& peaks) {
     size_t  peaksOneThirdSize{static_cast<size_t>(peaks.size()/3)},
@@ -59,145 +69,441 @@ CycleData ColData::calculateCycleData(const vector<double>& crests,
 //----------------------------------------------------------------------------//
 //*************************** ColData::IntV Class ****************************//
 //----------------------------------------------------------------------------//
-IntV::IntV(int colNo, string colName, size_t dataRowTotal) :
-  m_id{s_total++}, m_colNo{colNo}, m_colName{colName}, m_data{} {
-    for (IntV* iVP : s_intVSetP) {
-        if (m_colName == iVP->m_colName) {
-            throw runtime_error(errorColNameInt);
-        }
-    }
-    m_data.reserve(dataRowTotal);
-    s_intVSetP.push_back(this);
+IntV::IntV(Table& table, int colNo, string colName, size_t dataRowTotal) :
+  m_table{table}, m_id{static_cast<int>(table.getIntVSetP().size())},
+  m_colNo{colNo}, m_colName{colName}, m_values{}, m_data{} {
+    m_table.addColumn(this);
+    m_values.reserve(dataRowTotal);
+}
+IntV::IntV(Table& table, int colNo, string colName, ColSpan<int> data) :
+  IntV(table, colNo, colName, 0) {
+    m_data = data;
+    for (size_t r=1; r<m_data.size(); ++r) { orderRow(r); }
+}
+void IntV::addValue(int value) {
+    m_values.emplace_back(value);
+    m_data = ColSpan<int>{m_values};
+    if (m_data.size() > 1) { orderRow(m_data.size() - 1); }
+}
+/*
+ * Update the order of the values with the step from the previous row to the
+ * given one, which must not be the first.
+ */
+void IntV::orderRow(const size_t row) {
+    const long long step{
+        static_cast<long long>(m_data[row]) - m_data[row - 1]
+    };
+    if (step <= 0)              { m_increasing = false; }
+    if (row == 1)               { m_stride = step; }
+    else if (step != m_stride)  { m_uniform = false; }
+}
+void IntV::insertColNoSet(int colNo) {
+    Table::getCurrent().getIntColNoSet().insert(colNo);
 }
-void IntV::addValue(int value)          { m_data.emplace_back(value); }
-void IntV::insertColNoSet(int colNo)    { s_intVColNoSet.insert(colNo); }
 
 int IntV::getId() const                 { return m_id; }
 int IntV::getColNo() const              { return m_colNo; }
 const string& IntV::getColName() const  { return m_colName; }
 int IntV::getCol(int colNo) const       { return colNo = m_colNo; }
 string& IntV::getCol(string& colName) const { return colName = m_colName; }
-const vector<int>& IntV::getData() const{ return m_data; }
+const ColSpan<int>& IntV::getData() const{ return m_data; }
 tuple<bool, size_t, size_t> IntV::getTimestepRange() const {
     // bool represents timestep column consistency (true for consistent)
     // first size_t is beginning timestep and last one is final timestep
-    if (m_data[0] < 0) {
+    if (m_data[0] < 0 || !m_increasing) {
         return {false, 0, 0};
     }
-    for (size_t i=1; i<m_data.size(); ++i) {
-        if (m_data[i] <= m_data[i-1]) {
-            return {false, 0, 0};
-        }
-    }
     return {true, m_data[0], m_data[m_data.size() - 1]};
 }
+/*
+ * Find the row of the given timestep, or the size of the column if it is not
+ * there. Uniformly increasing timesteps are indexed directly and increasing
+ * ones are searched in halves; any others are scanned.
+ */
 size_t IntV::getRow(int timestepVal) const {
+    if (m_increasing && m_uniform && m_stride > 0) {
+        const long long offset{
+            static_cast<long long>(timestepVal) - m_data[0]
+        };
+        if (offset < 0 || offset%m_stride != 0
+                || static_cast<size_t>(offset/m_stride) >= m_data.size()) {
+            return m_data.size();
+        }
+        return static_cast<size_t>(offset/m_stride);
+    }
+    if (m_increasing) {
+        const int* pos{
+            std::lower_bound(m_data.cbegin(), m_data.cend(), timestepVal)
+        };
+        if (pos == m_data.cend() || *pos != timestepVal) {
+            return m_data.size();
+        }
+        return std::distance(m_data.cbegin(), pos);
+    }
     return std::distance(
         m_data.cbegin(), std::find(m_data.cbegin(), m_data.cend(), timestepVal)
     );
 }
 
-int IntV::getTotal()                    { return s_total; }
-set<int>& IntV::getColNoSet()           { return s_intVColNoSet; }
-vector<IntV*>& IntV::getSetP()          { return s_intVSetP; }
-IntV* IntV::getOneP(const int id)       { return s_intVSetP[id]; }
-/*
+int IntV::getTotal() {
+    return static_cast<int>(Table::getCurrent().getIntVSetP().size());
+}
+set<int>& IntV::getColNoSet()   { return Table::getCurrent().getIntColNoSet(); }
+vector<IntV*>& IntV::getSetP()  { return Table::getCurrent().getIntVSetP(); }
+IntV* IntV::getOneP(const int id) {
+    return Table::getCurrent().getIntVSetP()[id];
+}
 IntV* IntV::getOnePFromCol(const int inputColNo) {
-    int id{-1};
-    for (IntV* iVP : s_intVSetP) {
-        if (inputColNo == iVP->m_colNo) { id = iVP->m_id; }
-    }
-    if (id<0) { throw runtime_error(errorColNoAbsent); }
-    return s_intVSetP[id];
+    return Table::getCurrent().findIntV(inputColNo);
 }
-IntV* IntV::getOnePFromCol(const string inputColName) {
-    int id{-1};
-    for (IntV* iVP : s_intVSetP) {
-        if (inputColName == iVP->m_colName) { id = iVP->m_id; }
-    }
-    if (id<0) { throw runtime_error(errorColNameAbsent); }
-    return s_intVSetP[id];
+IntV* IntV::getOnePFromCol(const string& inputColName) {
+    return Table::getCurrent().findIntV(inputColName);
 }
- */
 //----------------------------------------------------------------------------//
 //************************** ColData::DoubleV Class **************************//
 //----------------------------------------------------------------------------//
-DoubleV::DoubleV(int colNo, string colName, size_t dataRowTotal) :
-  m_id{s_total++}, m_colNo{colNo}, m_colName{colName}, m_data{} {
-    for (DoubleV* dVP : s_doubleVSetP) {
-        if (m_colName == dVP->m_colName) {
-            throw runtime_error(errorColNameDouble);
-        }
+DoubleV::DoubleV(Table& table, int colNo, string colName,
+        size_t dataRowTotal) :
+  m_table{table}, m_id{static_cast<int>(table.getDoubleVSetP().size())},
+  m_colNo{colNo}, m_colName{colName}, m_floatStored{s_floatStorage},
+  m_values{}, m_floatValues{}, m_data{}, m_floatData{} {
+    m_table.addColumn(this);
+    if (m_floatStored)  { m_floatValues.reserve(dataRowTotal); }
+    else                { m_values.reserve(dataRowTotal); }
+}
+DoubleV::DoubleV(Table& table, int colNo, string colName,
+        ColumnBuffer&& data) :
+  DoubleV(table, colNo, colName, 0) {
+    storeData(data);
+}
+DoubleV::DoubleV(Table& table, int colNo, string colName,
+        ColSpan<double> data) :
+  DoubleV(table, colNo, colName, 0) {
+    m_floatStored = false;
+    m_data = data;
+}
+void DoubleV::addValue(double value) {
+    if (m_floatStored) {
+        m_floatValues.emplace_back(static_cast<float>(value));
+        m_floatData = ColSpan<float>{m_floatValues};
+    }
+    else {
+        m_values.emplace_back(value);
+        m_data = ColSpan<double>{m_values};
     }
-    m_data.reserve(dataRowTotal);
-    s_doubleVSetP.push_back(this);
 }
-void DoubleV::addValue(double value)          { m_data.emplace_back(value); }
-void DoubleV::insertColNoSet(int colNo)       {s_doubleVColNoSet.insert(colNo);}
+void DoubleV::insertColNoSet(int colNo) {
+    Table::getCurrent().getDoubleColNoSet().insert(colNo);
+}
+/*
+ * Store the data columns created from now on as float instead of double, to
+ * halve their memory; the calculations on them still accumulate in double.
+ */
+void DoubleV::setFloatStorage(const bool floatStorage) {
+    s_floatStorage = floatStorage;
+}
+bool DoubleV::getFloatStorage() { return s_floatStorage; }
+void DoubleV::setPrefixSums(const bool prefixSums) {
+    s_prefixSums = prefixSums;
+}
+void DoubleV::setSource(const ColumnSource* sourceP) { m_sourceP = sourceP; }
+/*
+ * Decode the column from its source, if it has one, the first time that its
+ * values are read. The columns may be read from several threads at once.
+ */
+void DoubleV::decode() const {
+    if (!m_sourceP) { return; }
+    std::call_once(m_decodedFlag, [this]() {
+        ColumnBuffer values{m_floatStored};
+        m_sourceP->decodeColumn(m_colNo, values);
+        storeData(values);
+    });
+}
+/*
+ * Store the parsed or decoded values of the column in the arena of its table,
+ * release them and find the zone statistics of the column. The values of a
+ * buffer placed in the arena are kept where they were parsed.
+ */
+void DoubleV::storeData(ColumnBuffer& data) const {
+    ColumnArena& arena{m_table.getArena()};
+    if (data.isPlaced() && m_floatStored == data.isFloatStored()) {
+        if (m_floatStored)  { m_floatData = data.getFloatValues(); }
+        else                { m_data = data.getValues(); }
+    }
+    else if (m_floatStored && data.isFloatStored()) {
+        m_floatData = arena.store<float>(data.getFloatValues());
+    }
+    else if (m_floatStored) {
+        m_floatData = arena.store<float>(data.getValues());
+    }
+    else {
+        m_data = arena.store<double>(data.getValues());
+    }
+    data.release();
+    if (m_floatStored)  { findZoneStats(m_floatData); }
+    else                { findZoneStats(m_data); }
+}
 
 int DoubleV::getId() const                    { return m_id; }
 int DoubleV::getColNo() const                 { return m_colNo; }
 const string& DoubleV::getColName() const     { return m_colName; }
-const vector<double>& DoubleV::getData() const{ return m_data; }
+bool DoubleV::isFloatStored() const           { return m_floatStored; }
+const ColSpan<double>& DoubleV::getData() const {
+    decode();
+    return m_data;
+}
+size_t DoubleV::getSize() const {
+    decode();
+    return m_floatStored ? m_floatData.size() : m_data.size();
+}
+double DoubleV::getValue(const size_t row) const {
+    decode();
+    return m_floatStored ? m_floatData[row] : m_data[row];
+}
+vector<double> DoubleV::copyData() const {
+    return visitData([](const auto& data) {
+        return vector<double>(data.cbegin(), data.cend());
+    });
+}
 
-int DoubleV::getTotal()                       { return s_total; }
-set<int>& DoubleV::getColNoSet()              { return s_doubleVColNoSet; }
-vector<DoubleV*>& DoubleV::getSetP()          { return s_doubleVSetP; }
-DoubleV* DoubleV::getOneP(const int id)       { return s_doubleVSetP[id]; }
+int DoubleV::getTotal() {
+    return static_cast<int>(Table::getCurrent().getDoubleVSetP().size());
+}
+set<int>& DoubleV::getColNoSet() {
+    return Table::getCurrent().getDoubleColNoSet();
+}
+vector<DoubleV*>& DoubleV::getSetP() {
+    return Table::getCurrent().getDoubleVSetP();
+}
+DoubleV* DoubleV::getOneP(const int id) {
+    return Table::getCurrent().getDoubleVSetP()[id];
+}
 DoubleV* DoubleV::getOnePFromCol(const int inputColNo) {
-    int id{-1};
-    for (DoubleV* dVP : s_doubleVSetP) {
-        if (inputColNo == dVP->m_colNo) { id = dVP->m_id; }
+    return Table::getCurrent().findDoubleV(inputColNo);
+}
+DoubleV* DoubleV::getOnePFromCol(const string& inputColName) {
+    return Table::getCurrent().findDoubleV(inputColName);
+}
+
+// Zone statistics -----------------------------------------------------------//
+/*
+ * Find the sums of each block of zoneBlockRows rows; those of the last block,
+ * which may be shorter, are found but never combined.
+ */
+template<typename T>
+void DoubleV::findZoneStats(const ColSpan<T>& data) const {
+    m_zoneStatsSet.clear();
+    for (size_t bgn=0; bgn<data.size(); bgn+=zoneBlockRows) {
+        const size_t end{std::min(bgn + zoneBlockRows, data.size())};
+        ZoneStats zone{0.0, 0.0, 0.0};
+        for (size_t r=bgn; r<end; ++r) {
+            const double x{data[r]};
+            zone.sum += x;
+            zone.sumOfSquares += x*x;
+            zone.sumOfCubes += x*x*x;
+        }
+        m_zoneStatsSet.push_back(zone);
     }
-    if (id<0) { throw runtime_error(errorColNoAbsent); }
-    return s_doubleVSetP[id];
 }
-DoubleV* DoubleV::getOnePFromCol(const string inputColName) {
-    int id{-1};
-    for (DoubleV* dVP : s_doubleVSetP) {
-        if (inputColName == dVP->m_colName) { id = dVP->m_id; }
+
+/*
+ * Reduce the rows from rowBgn to rowEnd into the given value, one row at a
+ * time in the blocks at the edges and one block at a time from the zone
+ * statistics of the whole blocks in between, if the column has them.
+ */
+template<typename T, typename R, typename Z>
+double DoubleV::reduceRows(const ColSpan<T>& data, const size_t rowBgn,
+        const size_t rowEnd, double value, R reduceRow, Z reduceZone) const {
+    size_t r{rowBgn};
+    const size_t blockBgn{(rowBgn + zoneBlockRows - 1)/zoneBlockRows};
+    const size_t blockEnd{(rowEnd + 1)/zoneBlockRows};
+    if (!m_zoneStatsSet.empty() && blockBgn < blockEnd) {
+        for (; r<blockBgn*zoneBlockRows; ++r) {
+            value = reduceRow(value, data[r]);
+        }
+        for (size_t b=blockBgn; b<blockEnd; ++b) {
+            value = reduceZone(value, m_zoneStatsSet[b]);
+        }
+        r = blockEnd*zoneBlockRows;
+    }
+    for (; r<=rowEnd; ++r) {
+        value = reduceRow(value, data[r]);
     }
-    if (id<0) { throw runtime_error(errorColNameAbsent); }
-    return s_doubleVSetP[id];
+    return value;
 }
 
-// Summations ----------------------------------------------------------------//
-double DoubleV::getSum(const size_t rowBgn, const size_t rowEnd) const {
-    double sum{0};
-    for (size_t r=rowBgn; r<=rowEnd; ++r) {
-        sum += m_data[r];
+// Range extrema -------------------------------------------------------------//
+/*
+ * Combine the extrema of a range of rows with those of another range, or with
+ * a row.
+ */
+static void combineExtrema(RangeExtrema& extrema, const RangeExtrema& other) {
+    if (extrema.min > other.min) { extrema.min = other.min; }
+    if (extrema.max < other.max) { extrema.max = other.max; }
+    if (extrema.absMin > other.absMin) { extrema.absMin = other.absMin; }
+}
+static void combineExtrema(RangeExtrema& extrema, const double x) {
+    if (extrema.min > x) { extrema.min = x; }
+    if (extrema.max < x) { extrema.max = x; }
+    if (extrema.absMin > std::abs(x)) { extrema.absMin = std::abs(x); }
+}
+
+/*
+ * Find the sparse table of the extrema of the whole blocks of extremaBlockRows
+ * rows, whose level k holds the extrema of every run of 2^k blocks.
+ */
+template<typename T>
+void DoubleV::findExtremaTable(const ColSpan<T>& data) const {
+    constexpr double inf{numeric_limits<double>::infinity()};
+    const size_t blockTotal{data.size()/extremaBlockRows};
+    m_extremaTable.assign(1, vector<RangeExtrema>(blockTotal));
+    for (size_t b=0; b<blockTotal; ++b) {
+        RangeExtrema extrema{inf, -inf, inf};
+        for (size_t r=b*extremaBlockRows; r<(b+1)*extremaBlockRows; ++r) {
+            combineExtrema(extrema, data[r]);
+        }
+        m_extremaTable[0][b] = extrema;
+    }
+    for (size_t run=2; run<=blockTotal; run*=2) {
+        const vector<RangeExtrema>& level{m_extremaTable.back()};
+        vector<RangeExtrema> nextLevel(blockTotal - run + 1);
+        for (size_t b=0; b<nextLevel.size(); ++b) {
+            nextLevel[b] = level[b];
+            combineExtrema(nextLevel[b], level[b + run/2]);
+        }
+        m_extremaTable.push_back(std::move(nextLevel));
     }
-    return sum;
 }
-double DoubleV::getSumOfSquares(const size_t rowBgn, const size_t rowEnd) const{
-    double sum{0};
-    for (size_t r=rowBgn; r<=rowEnd; ++r) {
-        double x{m_data[r]};
-        sum += x*x;
+
+/*
+ * Find the extrema of the rows from rowBgn to rowEnd, from the two runs of
+ * the sparse table that cover the whole blocks between them and from the rows
+ * of the blocks at the edges.
+ */
+template<typename T>
+RangeExtrema DoubleV::findRangeExtrema(const ColSpan<T>& data,
+        const size_t rowBgn, const size_t rowEnd) const {
+    constexpr double inf{numeric_limits<double>::infinity()};
+    RangeExtrema extrema{inf, -inf, inf};
+    size_t r{rowBgn};
+    const size_t blockBgn{(rowBgn + extremaBlockRows - 1)/extremaBlockRows};
+    const size_t blockEnd{(rowEnd + 1)/extremaBlockRows};
+    if (blockBgn < blockEnd) {
+        for (; r<blockBgn*extremaBlockRows; ++r) {
+            combineExtrema(extrema, data[r]);
+        }
+        size_t k{0};
+        while ((size_t{2} << k) <= blockEnd - blockBgn) { ++k; }
+        combineExtrema(extrema, m_extremaTable[k][blockBgn]);
+        combineExtrema(extrema,
+            m_extremaTable[k][blockEnd - (size_t{1} << k)]);
+        r = blockEnd*extremaBlockRows;
     }
-    return sum;
+    for (; r<=rowEnd; ++r) {
+        combineExtrema(extrema, data[r]);
+    }
+    return extrema;
 }
-double DoubleV::getSumOfCubes(const size_t rowBgn, const size_t rowEnd) const {
-    double sum{0};
-    for (size_t r=rowBgn; r<=rowEnd; ++r) {
-        double x{m_data[r]};
-        sum += x*x*x;
+
+/*
+ * Find the extrema of the rows from rowBgn to rowEnd, finding the sparse table
+ * first if it has not been. The table is kept for the rest of the session.
+ */
+RangeExtrema DoubleV::findRangeExtrema(const size_t rowBgn,
+        const size_t rowEnd) const {
+    return visitData([&](const auto& data) {
+        std::call_once(m_extremaFlag, [&]() { findExtremaTable(data); });
+        return findRangeExtrema(data, rowBgn, rowEnd);
+    });
+}
+
+// Prefix sums ---------------------------------------------------------------//
+/*
+ * Find the sums of the first three powers of the rows before each row, and
+ * after the last one, shifted by the mean of the column so that the sums stay
+ * small, and compensated by Neumaier summation.
+ */
+template<typename T>
+void DoubleV::findPrefixMoments(const ColSpan<T>& data) const {
+    m_prefixShift = 0.0;
+    for (const T x : data) { m_prefixShift += x; }
+    if (!data.empty()) { m_prefixShift /= static_cast<double>(data.size()); }
+
+    m_prefixMomentsSet.resize(data.size() + 1);
+    PrefixMoments moments{{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+    m_prefixMomentsSet[0] = moments;
+    for (size_t r=0; r<data.size(); ++r) {
+        const double y{data[r] - m_prefixShift};
+        const double terms[3]{y, y*y, y*y*y};
+        for (int p=0; p<3; ++p) {
+            const double sum{moments.sums[p] + terms[p]};
+            moments.errors[p] += std::abs(moments.sums[p]) >= std::abs(terms[p])
+                ? (moments.sums[p] - sum) + terms[p]
+                : (terms[p] - sum) + moments.sums[p];
+            moments.sums[p] = sum;
+        }
+        m_prefixMomentsSet[r+1] = moments;
     }
-    return sum;
 }
-double DoubleV::getSumOfSquaresOfDifference(const double diffVal,
+
+/*
+ * Find the sum of the given power, from 1 to 3, of the shifted rows from
+ * rowBgn to rowEnd, finding the prefix sums first if they have not been.
+ */
+double DoubleV::getShiftedSum(const int power, const size_t rowBgn,
+        const size_t rowEnd) const {
+    std::call_once(m_prefixFlag, [this]() {
+        visitData([this](const auto& data) { findPrefixMoments(data); });
+    });
+    const PrefixMoments& bgn{m_prefixMomentsSet[rowBgn]};
+    const PrefixMoments& end{m_prefixMomentsSet[rowEnd + 1]};
+    return (end.sums[power-1] - bgn.sums[power-1])
+        + (end.errors[power-1] - bgn.errors[power-1]);
+}
+
+// Summations ----------------------------------------------------------------//
+template<typename T>
+double DoubleV::getSum(const ColSpan<T>& data, const size_t rowBgn,
+        const size_t rowEnd) const {
+    return reduceRows(data, rowBgn, rowEnd, 0.0,
+        [](const double sum, const double x) { return sum + x; },
+        [](const double sum, const ZoneStats& zone) {
+            return sum + zone.sum;
+        });
+}
+template<typename T>
+double DoubleV::getSumOfSquares(const ColSpan<T>& data,
         const size_t rowBgn, const size_t rowEnd) const {
+    return reduceRows(data, rowBgn, rowEnd, 0.0,
+        [](const double sum, const double x) { return sum + x*x; },
+        [](const double sum, const ZoneStats& zone) {
+            return sum + zone.sumOfSquares;
+        });
+}
+template<typename T>
+double DoubleV::getSumOfCubes(const ColSpan<T>& data,
+        const size_t rowBgn, const size_t rowEnd) const {
+    return reduceRows(data, rowBgn, rowEnd, 0.0,
+        [](const double sum, const double x) { return sum + x*x*x; },
+        [](const double sum, const ZoneStats& zone) {
+            return sum + zone.sumOfCubes;
+        });
+}
+template<typename T>
+double DoubleV::getSumOfSquaresOfDifference(const ColSpan<T>& data,
+        const double diffVal, const size_t rowBgn, const size_t rowEnd) const {
     double sum{0};
     for (size_t r=rowBgn; r<=rowEnd; ++r) {
-        double x{m_data[r] - diffVal};
+        double x{data[r] - diffVal};
         sum += x*x;
     }
     return sum;
 }
 
 // Cycles --------------------------------------------------------------------//
-CycleData DoubleV::findCycles(const size_t rowBgn, const size_t rowEnd,
-        const double mean, const double minAmplitude,
+template<typename T>
+CycleData DoubleV::findCycles(const ColSpan<T>& data, const size_t rowBgn,
+        const size_t rowEnd, const double mean, const double minAmplitude,
         const size_t minRowInterval) const {
     size_t
         r{rowBgn}, rowInitial{rowBgn}, rowFinal{rowEnd}, rowLast{rowEnd},
@@ -208,17 +514,17 @@ CycleData DoubleV::findCycles(const size_t rowBgn, const size_t rowEnd,
     vector<double> crests, troughs, peaks;
 
     if (rowBgn>0)                    { --r; }
-    if (rowEnd == (m_data.size()-1)) { --rowLast; }
+    if (rowEnd == (data.size()-1)) { --rowLast; }
 
     while (r<=rowLast) {
-        if ((signbit(m_data[r] - mean) != signbit(m_data[r+1] - mean))
-                || (m_data[r] == mean && m_data[r] != m_data[r+1])) {
+        if ((signbit(data[r] - mean) != signbit(data[r+1] - mean))
+                || (data[r] == mean && data[r] != data[r+1])) {
             foundInitial = true;
-            if (std::abs(m_data[r] - mean) < std::abs(m_data[r+1] - mean)) {
+            if (std::abs(data[r] - mean) < std::abs(data[r+1] - mean)) {
                 rowInitial = r;
-                if ((m_data[r] != mean)
-                        || (m_data[r] == mean
-                            && signbit(m_data[r]) != signbit(m_data[r+1]))
+                if ((data[r] != mean)
+                        || (data[r] == mean
+                            && signbit(data[r]) != signbit(data[r+1]))
                         ) {
                     crossings = -1;
                 }
@@ -236,11 +542,11 @@ CycleData DoubleV::findCycles(const size_t rowBgn, const size_t rowEnd,
 
     r = rowInitial;
     while (r<=rowLast) {
-        cycleMin = (m_data[r] < cycleMin) ? m_data[r] : cycleMin;
-        cycleMax = (m_data[r] > cycleMax) ? m_data[r] : cycleMax;
+        cycleMin = (data[r] < cycleMin) ? data[r] : cycleMin;
+        cycleMax = (data[r] > cycleMax) ? data[r] : cycleMax;
         bool
             isSignbitDiff{
-                signbit(m_data[r] - mean) != signbit(m_data[r+1] - mean)
+                signbit(data[r] - mean) != signbit(data[r+1] - mean)
             },
             isCycleMaxLarge{std::abs(cycleMax - mean) >= minAmplitude},
             isCycleMinLarge{std::abs(cycleMin - mean) >= minAmplitude},
@@ -253,7 +559,7 @@ CycleData DoubleV::findCycles(const size_t rowBgn, const size_t rowEnd,
                         (isCycleMaxLarge && isCycleMinLarge)) ||
                     (crossings <  0)
                 )) ||
-                (crossings == 1 && r+2 > rowLast && m_data[r+1] == mean)
+                (crossings == 1 && r+2 > rowLast && data[r+1] == mean)
            ) {
             ++crossings;
             rL = r;
@@ -266,7 +572,7 @@ CycleData DoubleV::findCycles(const size_t rowBgn, const size_t rowEnd,
                 crossings = 0;
                 cycleMax = cycleMin = mean;
                 rowFinal =
-                    (std::abs(m_data[r] - mean)<std::abs(m_data[r+1] - mean)) ?
+                    (std::abs(data[r] - mean)<std::abs(data[r+1] - mean)) ?
                         r : (r+1);
             }
         }
@@ -280,9 +586,11 @@ CycleData DoubleV::findCycles(const size_t rowBgn, const size_t rowEnd,
     return cData;
 }
 
-CycleData DoubleV::findCyclesFirst(const size_t rowBgn, const size_t rowEnd,
-        const double mean, const double minAmplitude,
-        const size_t minRowInterval, const int cycles) const {
+template<typename T>
+CycleData DoubleV::findCyclesFirst(const ColSpan<T>& data,
+        const size_t rowBgn, const size_t rowEnd, const double mean,
+        const double minAmplitude, const size_t minRowInterval,
+        const int cycles) const {
     size_t
         r{rowBgn}, rowInitial{rowBgn}, rowFinal{rowEnd}, rowLast{rowEnd},
         rL{rowLast};
@@ -292,17 +600,17 @@ CycleData DoubleV::findCyclesFirst(const size_t rowBgn, const size_t rowEnd,
     vector<double> crests, troughs, peaks;
 
     if (rowBgn>0)                    { --r; }
-    if (rowEnd == (m_data.size()-1)) { --rowLast; }
+    if (rowEnd == (data.size()-1)) { --rowLast; }
 
     while (r<=rowLast) {
-        if ((signbit(m_data[r] - mean) != signbit(m_data[r+1] - mean))
-                || (m_data[r] == mean && m_data[r] != m_data[r+1])) {
+        if ((signbit(data[r] - mean) != signbit(data[r+1] - mean))
+                || (data[r] == mean && data[r] != data[r+1])) {
             foundInitial = true;
-            if (std::abs(m_data[r] - mean) < std::abs(m_data[r+1] - mean)) {
+            if (std::abs(data[r] - mean) < std::abs(data[r+1] - mean)) {
                 rowInitial = r;
-                if ((m_data[r] != mean)
-                        || (m_data[r] == mean
-                            && signbit(m_data[r]) != signbit(m_data[r+1]))
+                if ((data[r] != mean)
+                        || (data[r] == mean
+                            && signbit(data[r]) != signbit(data[r+1]))
                         ) {
                     crossings = -1;
                 }
@@ -320,11 +628,11 @@ CycleData DoubleV::findCyclesFirst(const size_t rowBgn, const size_t rowEnd,
 
     r = rowInitial;
     while (r<=rowLast && cycleCount<cycles) {
-        cycleMin = (m_data[r] < cycleMin) ? m_data[r] : cycleMin;
-        cycleMax = (m_data[r] > cycleMax) ? m_data[r] : cycleMax;
+        cycleMin = (data[r] < cycleMin) ? data[r] : cycleMin;
+        cycleMax = (data[r] > cycleMax) ? data[r] : cycleMax;
         bool
             isSignbitDiff{
-                signbit(m_data[r] - mean) != signbit(m_data[r+1] - mean)
+                signbit(data[r] - mean) != signbit(data[r+1] - mean)
             },
             isCycleMaxLarge{std::abs(cycleMax - mean) >= minAmplitude},
             isCycleMinLarge{std::abs(cycleMin - mean) >= minAmplitude},
@@ -337,7 +645,7 @@ CycleData DoubleV::findCyclesFirst(const size_t rowBgn, const size_t rowEnd,
                         (isCycleMaxLarge && isCycleMinLarge)) ||
                     (crossings <  0)
                 )) ||
-                (crossings == 1 && r+2 > rowLast && m_data[r+1] == mean)
+                (crossings == 1 && r+2 > rowLast && data[r+1] == mean)
            ) {
             ++crossings;
             rL = r;
@@ -350,7 +658,7 @@ CycleData DoubleV::findCyclesFirst(const size_t rowBgn, const size_t rowEnd,
                 crossings = 0;
                 cycleMax = cycleMin = mean;
                 rowFinal =
-                    (std::abs(m_data[r] - mean)<std::abs(m_data[r+1] - mean)) ?
+                    (std::abs(data[r] - mean)<std::abs(data[r+1] - mean)) ?
                         r : (r+1);
             }
         }
@@ -367,9 +675,11 @@ CycleData DoubleV::findCyclesFirst(const size_t rowBgn, const size_t rowEnd,
     return cData;
 }
 
-CycleData DoubleV::findCyclesLast(const size_t rowBgn, const size_t rowEnd,
-        const double mean, const double minAmplitude,
-        const size_t minRowInterval, const int cycles) const {
+template<typename T>
+CycleData DoubleV::findCyclesLast(const ColSpan<T>& data,
+        const size_t rowBgn, const size_t rowEnd, const double mean,
+        const double minAmplitude, const size_t minRowInterval,
+        const int cycles) const {
     size_t
         r{rowEnd}, rowFinal{rowEnd}, rowInitial{rowBgn}, rowFirst{rowBgn},
         rL{rowFirst};
@@ -379,17 +689,17 @@ CycleData DoubleV::findCyclesLast(const size_t rowBgn, const size_t rowEnd,
     vector<double> crests, troughs, peaks;
 
     if (rowBgn == 0)                { ++rowFirst; }
-    if (rowEnd < (m_data.size()-1)) { ++r; }
+    if (rowEnd < (data.size()-1)) { ++r; }
 
     while (r>=rowFirst) {
-        if ((signbit(m_data[r] - mean) != signbit(m_data[r-1] - mean))
-                || (m_data[r] == mean && m_data[r] != m_data[r-1])) {
+        if ((signbit(data[r] - mean) != signbit(data[r-1] - mean))
+                || (data[r] == mean && data[r] != data[r-1])) {
             foundFinal = true;
-            if (std::abs(m_data[r] - mean) < std::abs(m_data[r-1] - mean)) {
+            if (std::abs(data[r] - mean) < std::abs(data[r-1] - mean)) {
                 rowFinal = r;
-                if ((m_data[r] != mean)
-                        || (m_data[r] == mean
-                            && signbit(m_data[r]) != signbit(m_data[r-1]))
+                if ((data[r] != mean)
+                        || (data[r] == mean
+                            && signbit(data[r]) != signbit(data[r-1]))
                         ) {
                     crossings = -1;
                 }
@@ -407,11 +717,11 @@ CycleData DoubleV::findCyclesLast(const size_t rowBgn, const size_t rowEnd,
 
     r = rowFinal;
     while (r>=rowFirst && cycleCount<cycles) {
-        cycleMin = (m_data[r] < cycleMin) ? m_data[r] : cycleMin;
-        cycleMax = (m_data[r] > cycleMax) ? m_data[r] : cycleMax;
+        cycleMin = (data[r] < cycleMin) ? data[r] : cycleMin;
+        cycleMax = (data[r] > cycleMax) ? data[r] : cycleMax;
         bool
             isSignbitDiff{
-                signbit(m_data[r] - mean) != signbit(m_data[r-1] - mean)
+                signbit(data[r] - mean) != signbit(data[r-1] - mean)
             },
             isCycleMaxLarge{std::abs(cycleMax - mean) >= minAmplitude},
             isCycleMinLarge{std::abs(cycleMin - mean) >= minAmplitude},
@@ -424,7 +734,7 @@ CycleData DoubleV::findCyclesLast(const size_t rowBgn, const size_t rowEnd,
                         (isCycleMaxLarge && isCycleMinLarge)) ||
                     (crossings <  0)
                 )) ||
-                (crossings == 1 && r-2 < rowFirst && m_data[r-1] == mean)
+                (crossings == 1 && r-2 < rowFirst && data[r-1] == mean)
            ) {
             ++crossings;
             rL = r;
@@ -437,7 +747,7 @@ CycleData DoubleV::findCyclesLast(const size_t rowBgn, const size_t rowEnd,
                 crossings = 0;
                 cycleMax = cycleMin = mean;
                 rowInitial =
-                    (std::abs(m_data[r] - mean)<std::abs(m_data[r-1] - mean)) ?
+                    (std::abs(data[r] - mean)<std::abs(data[r-1] - mean)) ?
                         r : (r-1);
             }
         }
@@ -454,25 +764,291 @@ CycleData DoubleV::findCyclesLast(const size_t rowBgn, const size_t rowEnd,
     return cData;
 }
 
+// Dispatch on the storage of the column -------------------------------------//
+double DoubleV::getMin(const size_t rowBgn, const size_t rowEnd) const {
+    return findRangeExtrema(rowBgn, rowEnd).min;
+}
+double DoubleV::getMax(const size_t rowBgn, const size_t rowEnd) const {
+    return findRangeExtrema(rowBgn, rowEnd).max;
+}
+double DoubleV::getAbsMin(const size_t rowBgn, const size_t rowEnd) const {
+    return findRangeExtrema(rowBgn, rowEnd).absMin;
+}
+double DoubleV::getAbsMax(const size_t rowBgn, const size_t rowEnd) const {
+    const RangeExtrema extrema{findRangeExtrema(rowBgn, rowEnd)};
+    return std::max(std::abs(extrema.min), std::abs(extrema.max));
+}
+// With prefix sums, the sums of the powers of the rows are expanded from the
+// sums of the powers of the shifted rows, which are found in constant time.
+double DoubleV::getSum(const size_t rowBgn, const size_t rowEnd) const {
+    if (s_prefixSums) {
+        const double n{static_cast<double>(rowEnd - rowBgn + 1)};
+        const double s1{getShiftedSum(1, rowBgn, rowEnd)};
+        return s1 + n*m_prefixShift;
+    }
+    return visitData([&](const auto& data) {
+        return getSum(data, rowBgn, rowEnd);
+    });
+}
+double DoubleV::getSumOfSquares(const size_t rowBgn, const size_t rowEnd) const{
+    if (s_prefixSums) {
+        const double n{static_cast<double>(rowEnd - rowBgn + 1)};
+        const double s1{getShiftedSum(1, rowBgn, rowEnd)};
+        const double s2{getShiftedSum(2, rowBgn, rowEnd)};
+        const double k{m_prefixShift};
+        return s2 + 2.0*k*s1 + n*k*k;
+    }
+    return visitData([&](const auto& data) {
+        return getSumOfSquares(data, rowBgn, rowEnd);
+    });
+}
+double DoubleV::getSumOfCubes(const size_t rowBgn, const size_t rowEnd) const {
+    if (s_prefixSums) {
+        const double n{static_cast<double>(rowEnd - rowBgn + 1)};
+        const double s1{getShiftedSum(1, rowBgn, rowEnd)};
+        const double s2{getShiftedSum(2, rowBgn, rowEnd)};
+        const double s3{getShiftedSum(3, rowBgn, rowEnd)};
+        const double k{m_prefixShift};
+        return s3 + 3.0*k*s2 + 3.0*k*k*s1 + n*k*k*k;
+    }
+    return visitData([&](const auto& data) {
+        return getSumOfCubes(data, rowBgn, rowEnd);
+    });
+}
+double DoubleV::getSumOfSquaresOfDifference(const double diffVal,
+        const size_t rowBgn, const size_t rowEnd) const {
+    if (s_prefixSums) {
+        // Sum of (y - d)^2 over the shifted rows y, where d = diffVal - shift
+        const double n{static_cast<double>(rowEnd - rowBgn + 1)};
+        const double s1{getShiftedSum(1, rowBgn, rowEnd)};
+        const double s2{getShiftedSum(2, rowBgn, rowEnd)};
+        const double d{diffVal - m_prefixShift};
+        return std::max(s2 - 2.0*d*s1 + n*d*d, 0.0);
+    }
+    return visitData([&](const auto& data) {
+        return getSumOfSquaresOfDifference(data, diffVal, rowBgn, rowEnd);
+    });
+}
+CycleData DoubleV::findCycles(const size_t rowBgn, const size_t rowEnd,
+        const double mean, const double minAmplitude,
+        const size_t minRowInterval) const {
+    return visitData([&](const auto& data) {
+        return findCycles(data, rowBgn, rowEnd, mean, minAmplitude,
+            minRowInterval);
+    });
+}
+CycleData DoubleV::findCyclesFirst(const size_t rowBgn, const size_t rowEnd,
+        const double mean, const double minAmplitude,
+        const size_t minRowInterval, const int cycles) const {
+    return visitData([&](const auto& data) {
+        return findCyclesFirst(data, rowBgn, rowEnd, mean, minAmplitude,
+            minRowInterval, cycles);
+    });
+}
+CycleData DoubleV::findCyclesLast(const size_t rowBgn, const size_t rowEnd,
+        const double mean, const double minAmplitude,
+        const size_t minRowInterval, const int cycles) const {
+    return visitData([&](const auto& data) {
+        return findCyclesLast(data, rowBgn, rowEnd, mean, minAmplitude,
+            minRowInterval, cycles);
+    });
+}
+
+//----------------------------------------------------------------------------//
+//************************ ColData::ColumnArena Class ************************//
+//----------------------------------------------------------------------------//
+ColumnArena::~ColumnArena() {
+    for (const auto& [bgn, size] : m_chunks) { munmap(bgn, size); }
+}
+
+void ColumnArena::setHugePages(const bool hugePages) {
+    s_hugePages = hugePages;
+}
+
+/*
+ * Map a chunk of at least the given size, in whole pages, and return it.
+ */
+tuple<char*, size_t> ColumnArena::mapChunk(const size_t bytes) {
+    const size_t pageBytes{s_hugePages ? hugePageBytes : 4096};
+    const size_t chunkBytes{(bytes + pageBytes - 1)/pageBytes*pageBytes};
+    void* chunk{MAP_FAILED};
+    if (s_hugePages) {
+        chunk = mmap(nullptr, chunkBytes, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+    if (chunk == MAP_FAILED) {
+        chunk = mmap(nullptr, chunkBytes, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (chunk == MAP_FAILED) { throw std::bad_alloc(); }
+        if (s_hugePages) { madvise(chunk, chunkBytes, MADV_HUGEPAGE); }
+    }
+    return {static_cast<char*>(chunk), chunkBytes};
+}
+
+/*
+ * Hand out a buffer of the given size, aligned to cacheAlignment bytes, from
+ * the current chunk, mapping a new one if it does not fit; a buffer of a chunk
+ * or more is given a chunk of its own. Buffers may be taken from several
+ * threads at once.
+ */
+void* ColumnArena::allocate(const size_t bytes) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    const size_t alignedBytes{
+        std::max<size_t>((bytes + cacheAlignment - 1)/cacheAlignment
+            *cacheAlignment, cacheAlignment)
+    };
+    if (alignedBytes >= arenaChunkBytes) {
+        m_chunks.push_back(mapChunk(alignedBytes));
+        return get<0>(m_chunks.back());
+    }
+    if (m_chunkUsed + alignedBytes > m_chunkBytes) {
+        tie(m_chunkBgn, m_chunkBytes) = mapChunk(arenaChunkBytes);
+        m_chunks.emplace_back(m_chunkBgn, m_chunkBytes);
+        m_chunkUsed = 0;
+    }
+    void* buffer{m_chunkBgn + m_chunkUsed};
+    m_chunkUsed += alignedBytes;
+    return buffer;
+}
+
+/*
+ * Place the given buffer in a buffer of the arena of the given number of rows,
+ * so that its values are parsed where the column keeps them.
+ */
+void ColumnArena::place(ColumnBuffer& buffer, const size_t rowTotal) {
+    buffer.place(allocate(rowTotal*buffer.getValueBytes()), rowTotal);
+}
+
+//----------------------------------------------------------------------------//
+//*************************** ColData::Table Class ***************************//
+//----------------------------------------------------------------------------//
+Table::~Table() {
+    for (IntV* iVP : m_intVSetP)        { delete iVP; }
+    for (DoubleV* dVP : m_doubleVSetP)  { delete dVP; }
+    for (ColumnSource* sourceP : m_sourceSetP) { delete sourceP; }
+    if (s_currentP == this) { s_currentP = nullptr; }
+}
+
+/*
+ * Return the current table, which is the table of the input file unless
+ * another one has been made current.
+ */
+Table& Table::getCurrent() {
+    static Table fileTable{};
+    if (!s_currentP) { s_currentP = &fileTable; }
+    return *s_currentP;
+}
+void Table::setCurrent(Table& table) { s_currentP = &table; }
+
+/*
+ * Add a column that is being created to the table, which then owns it; its
+ * name must not repeat that of another column of its type.
+ */
+void Table::addColumn(IntV* iVP) {
+    if (!m_intVColNameMap.emplace(iVP->getColName(), iVP).second) {
+        throw runtime_error(errorColNameInt);
+    }
+    m_intVColNoMap.emplace(iVP->getColNo(), iVP);
+    m_intVSetP.push_back(iVP);
+}
+void Table::addColumn(DoubleV* dVP) {
+    if (!m_doubleVColNameMap.emplace(dVP->getColName(), dVP).second) {
+        throw runtime_error(errorColNameDouble);
+    }
+    m_doubleVColNoMap.emplace(dVP->getColNo(), dVP);
+    m_doubleVSetP.push_back(dVP);
+}
+void Table::addSource(ColumnSource* sourceP) {
+    m_sourceSetP.push_back(sourceP);
+}
+
+set<int>& Table::getIntColNoSet()               { return m_intColNoSet; }
+set<int>& Table::getDoubleColNoSet()            { return m_doubleColNoSet; }
+vector<IntV*>& Table::getIntVSetP()             { return m_intVSetP; }
+vector<DoubleV*>& Table::getDoubleVSetP()       { return m_doubleVSetP; }
+ColumnArena& Table::getArena()                  { return m_arena; }
+IntV* Table::findIntV(const int colNo) const {
+    const auto it{m_intVColNoMap.find(colNo)};
+    if (it == m_intVColNoMap.cend()) { throw runtime_error(errorColNoAbsent); }
+    return it->second;
+}
+IntV* Table::findIntV(const string& colName) const {
+    const auto it{m_intVColNameMap.find(colName)};
+    if (it == m_intVColNameMap.cend()) {
+        throw runtime_error(errorColNameAbsent);
+    }
+    return it->second;
+}
+DoubleV* Table::findDoubleV(const int colNo) const {
+    const auto it{m_doubleVColNoMap.find(colNo)};
+    if (it == m_doubleVColNoMap.cend()) {
+        throw runtime_error(errorColNoAbsent);
+    }
+    return it->second;
+}
+DoubleV* Table::findDoubleV(const string& colName) const {
+    const auto it{m_doubleVColNameMap.find(colName)};
+    if (it == m_doubleVColNameMap.cend()) {
+        throw runtime_error(errorColNameAbsent);
+    }
+    return it->second;
+}
+
 //----------------------------------------------------------------------------//
 //************************* Data loading and storage *************************//
 //----------------------------------------------------------------------------//
 /*
  * Load file and call all the relevant functions to process it and return all
- * the required variables to CmdArgs::FileIn::process().
+ * the required variables to CmdArgs::FileIn::process(). The memory-mapped
+ * single-pass loader is used if it has been requested, and the columns are
+ * mapped from the column cache if it has been. A compressed file, and the
+ * standard input, are piped through the reader thread into the parser, as is
+ * any other file if reading ahead of the parser has been requested. With a
+ * valid index of the file, the line positions, the classification of the
+ * columns and the number of rows are taken from it instead of being found from
+ * the file.
  */
-const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&>
-        ColData::loadData(const string& fileName, const string& dlm) {
+const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+        ColData::loadData(const string& fileName, const string& dlm,
+            const LoadOptions& loadOptions) {
+    DoubleV::setFloatStorage(loadOptions.floatStored);
+    ColumnArena::setHugePages(loadOptions.hugePages);
+    DoubleV::setPrefixSums(loadOptions.prefixSums);
+    if (loadOptions.cached) {
+        return loadCachedData(fileName, dlm, loadOptions);
+    }
+    if (fileName == stdinFileName
+            || findCompression(fileName) != Compression::none) {
+        return loadPipedData(fileName, dlm, loadOptions);
+    }
+    if (loadOptions.indexed) {
+        return loadIndexedData(fileName, dlm, loadOptions);
+    }
+    if (loadOptions.mapped) {
+        return loadMappedData(fileName, dlm, loadOptions);
+    }
+    if (loadOptions.readAheadBytes > 0) {
+        return loadPipedData(fileName, dlm, loadOptions);
+    }
+    const RowIndex* rowIndexP{loadOptions.rowIndexP};
+
     // Open file -------------------------------------------------------------//
     ifstream iFile{fileName};
     if (!iFile) { throw runtime_error(errorInputFile); }
     else { cout << "File found. Program initiated." << flush; }
+    s_bytesScanned = 0;
 
     // Process the header ----------------------------------------------------//
     size_t nonDataLines;
     streampos headerLinePos, dataLinePos;
-    tie(nonDataLines, headerLinePos, dataLinePos) =
-        findLinePositions(iFile, dlm);
+    if (rowIndexP) {
+        headerLinePos = rowIndexP->getHeaderOffset();
+        dataLinePos = rowIndexP->getDataOffset();
+    }
+    else {
+        tie(nonDataLines, headerLinePos, dataLinePos) =
+            findLinePositions(iFile, dlm);
+    }
 
     string headerLine;
     Delimitation headerDlmType;
@@ -486,19 +1062,34 @@ const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&>
     set<int> timeStepColCandidates{
         findTimestepColCandidates(dataColTotal, colNames)
     };
+    if (rowIndexP && rowIndexP->getDataColTotal() != dataColTotal) {
+        throw runtime_error(errorIndexFile);
+    }
 
     // Process the data ------------------------------------------------------//
-    Delimitation dataDlmType = parseColumnData(iFile, dlm, dataLinePos);
-    cout << "\rIn progress: Parsing column data..." << flush;
-    classifyColumns(iFile, dlm, dataDlmType, dataLinePos, dataColTotal,
-                    timeStepColCandidates);
-    const size_t dataRowTotal{findDataRowTotal(iFile, dataLinePos)};
+    Delimitation dataDlmType;
+    size_t dataRowTotal;
+    vector<bool> intColCandidates(dataColTotal, false);
+    if (rowIndexP) {
+        dataDlmType = rowIndexP->getDataDlmType();
+        if (rowIndexP->getTimestepColNo() >= 0) {
+            intColCandidates[rowIndexP->getTimestepColNo()] = true;
+        }
+        dataRowTotal = rowIndexP->getDataRowTotal();
+    }
+    else {
+        dataDlmType = parseColumnData(iFile, dlm, dataLinePos);
+        cout << "\rIn progress: Parsing column data..." << flush;
+        intColCandidates = classifyColumns(iFile, dlm, dataDlmType,
+            dataLinePos, dataColTotal, timeStepColCandidates);
+        dataRowTotal = findDataRowTotal(iFile, dataLinePos);
+    }
 
     // Store the data --------------------------------------------------------//
-    createVectors(colNames, dataRowTotal);
+    const vector<bool> selectedCols{selectColumns(colNames, loadOptions)};
     cout << "\rIn progress: Processing column data..." << flush;
-    populateVectors(iFile, dlm, dataColTotal, dataDlmType, dataLinePos,
-                    dataRowTotal);
+    dataRowTotal = populateVectors(iFile, dlm, colNames, dataDlmType,
+        dataLinePos, dataRowTotal, selectedCols, intColCandidates);
     cout << '\r' << string(38, ' ') << "\n" << flush;
     iFile.close();
 
@@ -506,9 +1097,20 @@ const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&>
     if (!IntV::getSetP().empty()) {
         dataTimestepIVP = IntV::getOneP(0);
     }
+    LoadStats loadStats{std::filesystem::file_size(fileName), s_bytesScanned};
 
     return {dataDlmType, dataColTotal, dataRowTotal, dataTimestepIVP,
-            DoubleV::getSetP()};
+            DoubleV::getSetP(), loadStats};
+}
+
+/*
+ * Read a line from the input file and add its length to the count of bytes
+ * scanned.
+ */
+bool ColData::readLine(ifstream& iFile, string& line) {
+    if (!getline(iFile, line)) { return false; }
+    s_bytesScanned += line.length() + (iFile.eof() ? 0 : 1);
+    return true;
 }
 
 /*
@@ -532,7 +1134,7 @@ tuple<size_t, streampos, streampos> ColData::findLinePositions(ifstream& iFile,
     streampos currentPos{0}, lastPos{0}, headerLinePos{0}, dataLinePos{0};
     iFile.clear(), iFile.seekg(0);
 
-    while (getline(iFile, line)) {
+    while (readLine(iFile, line)) {
         lastPos = currentPos;
         currentPos = iFile.tellg();
         if (!line.empty()) {
@@ -558,10 +1160,15 @@ tuple<size_t, streampos, streampos> ColData::findLinePositions(ifstream& iFile,
  */
 tuple<string, Delimitation> ColData::parseHeaderLine(
         ifstream& iFile, const string& dlm, const streampos headerLinePos) {
-    string iLine, oLine;
-    Delimitation headerDlmType;
+    string iLine;
     iFile.clear(), iFile.seekg(headerLinePos);
-    getline(iFile, iLine);
+    readLine(iFile, iLine);
+    return parseHeaderLine(iLine, dlm);
+}
+tuple<string, Delimitation> ColData::parseHeaderLine(string iLine,
+        const string& dlm) {
+    string oLine;
+    Delimitation headerDlmType;
 
     if (iLine.find('=') != string::npos) {
         istringstream iLineStream{iLine};
@@ -658,15 +1265,37 @@ set<int> ColData::findTimestepColCandidates(int dataColTotal,
     return timestepColCandidates;
 }
 
+/*
+ * Find the timestep column from a single row, as the leftmost timestep column
+ * candidate whose field is a non-negative integer; return -1 if there is none.
+ */
+int ColData::findTimestepColFromRow(stringV line, const string& dlm,
+        const Delimitation dataDlmType, const int dataColTotal,
+        const set<int>& timestepColCandidates) {
+    FieldTokenizer tokenizer{line, dlm, dataDlmType};
+    stringV field;
+    int value;
+    for (int c=0; c<dataColTotal && tokenizer.next(field); ++c) {
+        if (timestepColCandidates.count(c) && FieldTokenizer::isDigits(field)
+                && FieldTokenizer::toNumber(field, value)) {
+            return c;
+        }
+    }
+    return -1;
+}
+
 /*
  * Parse column data to find the delimitation type of column data.
  */
 Delimitation ColData::parseColumnData(ifstream& iFile,
         const string& dlm, const streampos dataLinePos) {
-    string  spacedNumStr{"0123456789Ee-+."}, delimitedNumStr{spacedNumStr+dlm},
-            line;
+    string line;
     iFile.clear(), iFile.seekg(dataLinePos);
-    getline(iFile, line);
+    readLine(iFile, line);
+    return parseColumnData(line, dlm);
+}
+Delimitation ColData::parseColumnData(stringV line, const string& dlm) {
+    string  spacedNumStr{"0123456789Ee-+."}, delimitedNumStr{spacedNumStr+dlm};
     if (all_of(line.begin(), line.end(), [&](char c) {
             return (isspace(c) || (spacedNumStr.find(c) != string::npos)); })) {
         return Delimitation::spaced;
@@ -685,163 +1314,176 @@ Delimitation ColData::parseColumnData(ifstream& iFile,
 }
 
 /*
- * Classify the columns into timestep column and data columns. Timestep column
- * is identified by selecting the leftmost integer column from the set of
- * timestepColCandidates.
+ * Narrow the timestep column candidates down to the integer columns from a
+ * sample of the data: a block of rows at the head, the middle and the tail of
+ * the data section, or the whole data section if it is small. The sample only
+ * rules candidates out, and the remaining candidates are verified on every row
+ * while the columns are populated. Return the remaining candidates by their
+ * column numbers.
  */
-void ColData::classifyColumns(ifstream& iFile, const string& dlm,
+vector<bool> ColData::classifyColumns(ifstream& iFile, const string& dlm,
         const Delimitation dataDlmType, const streampos dataLinePos,
-        const int dataColTotal, set<int>& timestepColCandidates) {
-    size_t pos{0}, dlmLen{dlm.length()};
-    string line;
-
-    iFile.clear(), iFile.seekg(dataLinePos);
+        const int dataColTotal, const set<int>& timestepColCandidates) {
+    vector<bool> intColCandidates(dataColTotal, false);
+    for (int c : timestepColCandidates) { intColCandidates[c] = true; }
 
-    if (dataDlmType == Delimitation::spaced) {
-        while(getline(iFile, line)) {
-            if (all_of(line.cbegin(), line.cend(), isspace)) { continue; }
-            istringstream lineStream{line};
-            for (int c=0; c<dataColTotal; ++c) {
-                string numStr;
-                lineStream >> numStr;
-                if (timestepColCandidates.count(c)) {
-                    if (all_of(numStr.begin(), numStr.end(), isdigit)) {
-                        break;
-                    }
-                    else {
-                        timestepColCandidates.erase(c);
-                        iFile.clear(), iFile.seekg(dataLinePos); // Reset
-                        break;
-                    }
-                }
-            }
-        }
+    iFile.clear(), iFile.seekg(0, std::ios::end);
+    const size_t dataBytes{static_cast<size_t>(iFile.tellg() - dataLinePos)};
+    vector<size_t> blockBgns{0};
+    size_t blockBytes{dataBytes};
+    if (dataBytes > 3*classifySampleBytes) {
+        blockBgns.push_back((dataBytes - classifySampleBytes)/2);
+        blockBgns.push_back(dataBytes - classifySampleBytes);
+        blockBytes = classifySampleBytes;
     }
-    else {
-        while(getline(iFile, line)) {
-            if (line.find(dlm) == string::npos) { continue; }
-            if (dataDlmType == Delimitation::spacedAndDelimited) {
-                line.erase(remove_if(line.begin(), line.end(), isspace),
-                    line.end());
-            }
-            for (int c=0; c<dataColTotal; ++c) {
-                pos = line.find(dlm);
-                if (timestepColCandidates.count(c)) {
-                    string numStr{line.substr(0, pos)};
-                    if (all_of(numStr.begin(), numStr.end(), isdigit)) {
-                        break;
-                    }
-                    else {
-                        timestepColCandidates.erase(c);
-                        iFile.clear(), iFile.seekg(dataLinePos); // Reset
-                        break;
-                    }
+
+    string line;
+    stringV field;
+    for (const size_t blockBgn : blockBgns) {
+        iFile.clear();
+        iFile.seekg(dataLinePos + static_cast<std::streamoff>(blockBgn));
+        if (blockBgn > 0) { readLine(iFile, line); }   // Rest of a line
+        for (size_t bytesRead{0};
+                bytesRead < blockBytes && readLine(iFile, line);
+                bytesRead += line.length() + 1) {
+            FieldTokenizer tokenizer{line, dlm, dataDlmType};
+            for (int c=0; c<dataColTotal && tokenizer.next(field); ++c) {
+                if (intColCandidates[c] && !FieldTokenizer::isDigits(field)) {
+                    intColCandidates[c] = false;
                 }
-                line.erase(0, pos+dlmLen);
             }
         }
     }
-    for (int c=0; c<dataColTotal; ++c) {
-        if (timestepColCandidates.count(c)) {
-            IntV::insertColNoSet(c);
-            break;
-        }
-    }
-    for (int c=0; c<dataColTotal; ++c) {
-        if (!IntV::getColNoSet().count(c)) {
-            DoubleV::insertColNoSet(c);
-        }
-    }
+    return intColCandidates;
 }
 
 /*
  * Find the total number of rows of data in the given file.
  */
 size_t ColData::findDataRowTotal(ifstream& iFile, const streampos dataLinePos) {
-    size_t dataRowTotal{0};
-    string line;
+    RowCounter rowCounter;
+    vector<char> buffer(minChunkBytes);
     iFile.clear(), iFile.seekg(dataLinePos);
 
-    while(getline(iFile, line)) {
-        if (!all_of(line.cbegin(), line.cend(), isspace)) { ++dataRowTotal; }
+    while (iFile.read(buffer.data(), buffer.size()) || iFile.gcount() > 0) {
+        const size_t bytesRead{static_cast<size_t>(iFile.gcount())};
+        rowCounter.count(buffer.data(), buffer.data() + bytesRead);
+        s_bytesScanned += bytesRead;
+    }
+    return rowCounter.getRowTotal();
+}
+
+/*
+ * Select the columns to be loaded. All the columns are selected unless the
+ * column selection has been pushed down to the loader, in which case only the
+ * columns given by their numbers or names are.
+ */
+vector<bool> ColData::selectColumns(const vector<string>& colNames,
+        const LoadOptions& loadOptions) {
+    const int dataColTotal{static_cast<int>(colNames.size())};
+    vector<bool> selectedCols(dataColTotal, !loadOptions.projected);
+    if (loadOptions.projected) {
+        for (int c=0; c<dataColTotal; ++c) {
+            if (loadOptions.colNos.count(c)
+                    || loadOptions.colNames.count(colNames[c])) {
+                selectedCols[c] = true;
+            }
+        }
+    }
+    return selectedCols;
+}
+
+/*
+ * Create the buffers into which the columns are parsed; the integer column
+ * candidates are parsed into double even with float storage, so that the
+ * timestep column keeps its exact values.
+ */
+vector<ColumnBuffer> ColData::createColumnBuffers(
+        const vector<bool>& intColCandidates) {
+    vector<ColumnBuffer> colData;
+    colData.reserve(intColCandidates.size());
+    for (const bool intColCandidate : intColCandidates) {
+        colData.emplace_back(DoubleV::getFloatStorage() && !intColCandidate);
     }
-    return dataRowTotal;
+    return colData;
 }
 
 /*
- * Create vectors for storing column data using the first line of the file.
+ * Create vectors for storing column data using the first line of the file. The
+ * data columns that are not selected are created empty, so that they can still
+ * be listed and matched by their names and numbers.
  */
 void ColData::createVectors(const vector<string>& colNames,
-        const size_t dataRowTotal) {
-    for (int colNo : IntV::getColNoSet()) {
-        new IntV(colNo, colNames[colNo], dataRowTotal);
+        const size_t dataRowTotal, const vector<bool>& selectedCols) {
+    Table& table{Table::getCurrent()};
+    for (int colNo : table.getIntColNoSet()) {
+        new IntV(table, colNo, colNames[colNo], dataRowTotal);
     }
-    for (int colNo : DoubleV::getColNoSet()) {
-        new DoubleV(colNo, colNames[colNo], dataRowTotal);
+    for (int colNo : table.getDoubleColNoSet()) {
+        new DoubleV(table, colNo, colNames[colNo],
+            selectedCols[colNo] ? dataRowTotal : 0);
     }
 }
 
 /*
  * Populate the column vectors by reading the respective column data from file.
+ * The file is read in blocks of pipeBlockBytes, and the complete lines of each
+ * block are scanned at once; the incomplete line at its end is carried to the
+ * next block. The selected data columns are parsed straight into the arena of
+ * the table, as the rows have been counted. The fields of the data columns
+ * that are not selected are skipped without being converted.
+ * The integer column candidates are verified in the same pass, and the
+ * timestep column is chosen from the remaining candidates once all the rows
+ * are read. Return the number of rows read.
  */
-void ColData::populateVectors(ifstream& iFile, const string& dlm,
-        const int dataColTotal, const Delimitation dataDlmType,
-        const streampos dataLinePos, const size_t dataRowTotal) {
-    size_t pos{0}, dlmLen{dlm.length()};
-    string line;
-    vector<IntV*> iVSetP{IntV::getSetP()};
-    vector<DoubleV*> dVSetP{DoubleV::getSetP()};
+size_t ColData::populateVectors(ifstream& iFile, const string& dlm,
+        const vector<string>& colNames, const Delimitation dataDlmType,
+        const streampos dataLinePos, const size_t dataRowTotal,
+        const vector<bool>& selectedCols, vector<bool>& intColCandidates) {
+    const int dataColTotal{static_cast<int>(colNames.size())};
+    vector<stringV> fields;
+    vector<FixedFormat> formats;
+    vector<bool> parsedCols(dataColTotal);
+    vector<ColumnBuffer> colData{createColumnBuffers(intColCandidates)};
+    ColumnArena& arena{Table::getCurrent().getArena()};
+    for (int c=0; c<dataColTotal; ++c) {
+        parsedCols[c] = selectedCols[c] || intColCandidates[c];
+        if (intColCandidates[c])    { colData[c].reserve(dataRowTotal); }
+        else if (parsedCols[c])     { arena.place(colData[c], dataRowTotal); }
+    }
 
     iFile.clear(), iFile.seekg(dataLinePos);
 
-    if (dataDlmType == Delimitation::spaced) {
-        while(getline(iFile, line)) {
-            if (all_of(line.cbegin(), line.cend(), isspace)) { continue; }
-            istringstream lineStream{line};
-            int iIndex{0}, dIndex{0};
-            for (int c=0; c<dataColTotal; ++c) {
-                string numStr;
-                lineStream >> numStr;
-                if (DoubleV::getColNoSet().count(c)) {
-                    dVSetP[dIndex++]->addValue(stod(numStr));
-                }
-                else {
-                    iVSetP[iIndex++]->addValue(stoi(numStr));
-                }
-            }
+    size_t rowsRead{0}, carried{0};
+    vector<char> buffer(pipeBlockBytes);
+    bool more{true};
+    while (more) {
+        if (carried == buffer.size()) { buffer.resize(2*buffer.size()); }
+        more = static_cast<bool>(
+            iFile.read(buffer.data() + carried, buffer.size() - carried));
+        const size_t bytesRead{static_cast<size_t>(iFile.gcount())};
+        s_bytesScanned += bytesRead;
+        const char* bgn{buffer.data()};
+        const char* end{bgn + carried + bytesRead};
+        const char* linesEnd{end};
+        if (more) {
+            while (linesEnd > bgn && *(linesEnd - 1) != '\n') { --linesEnd; }
         }
-    }
-    else {
-        while(getline(iFile, line)) {
-            if (line.find(dlm) == string::npos) { continue; }
-            if (dataDlmType == Delimitation::spacedAndDelimited) {
-                line.erase(remove_if(line.begin(), line.end(), isspace),
-                    line.end());
-            }
-            int iIndex{0}, dIndex{0};
-            for (int c=0; c<dataColTotal; ++c) {
-                string numStr{line.substr(0, pos=line.find(dlm))};
-                if (DoubleV::getColNoSet().count(c)) {
-                    dVSetP[dIndex++]->addValue(stod(numStr));
-                }
-                else {
-                    iVSetP[iIndex++]->addValue(stoi(numStr));
-                }
-                line.erase(0, pos+dlmLen);
-            }
+        RowScanner scanner{bgn, linesEnd, dlm, dataDlmType};
+        while (scanner.nextRow(fields)) {
+            parseDataRow(fields, dataColTotal, parsedCols, formats, colData,
+                intColCandidates);
+            ++rowsRead;
         }
+        carried = end - linesEnd;
+        std::memmove(buffer.data(), linesEnd, carried);
     }
     // Match the number of lines of data:
-    bool matchLineCount{true};
-    for (IntV* iVP : IntV::getSetP()) {
-        if (dataRowTotal != iVP->getData().size()) { matchLineCount = false; }
-    }
-    for (DoubleV* dVP : DoubleV::getSetP()) {
-        if (dataRowTotal != dVP->getData().size()) { matchLineCount = false; }
-    }
-    if (dataRowTotal == 0 || !matchLineCount) {
+    if (rowsRead == 0 || rowsRead != dataRowTotal) {
         throw runtime_error(errorDlmFormatIncorrect);
     }
+    storeMappedColumns(colNames, colData, intColCandidates, selectedCols);
+    return rowsRead;
 }
 
 /* First correctly working attempt with cycles starting anywhere!
@@ -14,28 +14,196 @@
 #include "namespaces.h"
 #include "errorMsgs.h"
 
+//----------------------------------------------------------------------------//
+//************************** ColData::ColSpan Class **************************//
+//----------------------------------------------------------------------------//
+/*
+ * Read-only view of the data of a column, which is either held by the column
+ * object itself or mapped from a column cache file.
+ */
+template<typename T>
+class ColData::ColSpan {
+  private:
+    const T*    m_bgn{nullptr};
+    size_t      m_size{0};
+
+  public:
+    ColSpan() = default;
+    ColSpan(const T* bgn, size_t size) : m_bgn{bgn}, m_size{size} {}
+    explicit ColSpan(const vector<T>& data) :
+      m_bgn{data.data()}, m_size{data.size()} {}
+
+    const T& operator[](size_t i) const { return m_bgn[i]; }
+    const T& front() const              { return m_bgn[0]; }
+    const T& back() const               { return m_bgn[m_size - 1]; }
+    const T* data() const               { return m_bgn; }
+    size_t size() const                 { return m_size; }
+    bool empty() const                  { return m_size == 0; }
+    const T* begin() const              { return m_bgn; }
+    const T* end() const                { return m_bgn + m_size; }
+    const T* cbegin() const             { return m_bgn; }
+    const T* cend() const               { return m_bgn + m_size; }
+};
+
+//----------------------------------------------------------------------------//
+//*********************** ColData::ColumnBuffer Class ************************//
+//----------------------------------------------------------------------------//
+/*
+ * Values of a column as they are parsed, before they are stored in the column.
+ * A column that is to be stored as float is parsed straight into float, so that
+ * its values are never held as double in full; the other columns, including
+ * the integer column candidates, are parsed into double. When the number of
+ * rows is known, the buffer is placed in the arena of the table beforehand,
+ * and the values are parsed into the memory that the column then keeps; a
+ * placed buffer cannot grow past its rows. A view of some of the rows of a
+ * placed buffer is parsed into in place, and is appended to it without a copy.
+ */
+class ColData::ColumnBuffer {
+  private:
+    bool            m_floatStored{false};
+    vector<double>  m_values{};
+    vector<float>   m_floatValues{};
+    double*         m_placedValues{nullptr};
+    float*          m_placedFloatValues{nullptr};
+    size_t          m_placedSize{0};
+    size_t          m_placedCapacity{0};
+
+    // Copy the first count of the given values after the values of the buffer,
+    // unless they are already there.
+    template<typename T, typename U>
+    void appendValues(const U* values, const size_t count, vector<T>& data,
+            T* placedData) {
+        if (!placedData) {
+            data.insert(data.end(), values, values + count);
+            return;
+        }
+        if (m_placedSize + count > m_placedCapacity) {
+            throw runtime_error(errorDlmFormatIncorrect);
+        }
+        T* dest{placedData + m_placedSize};
+        if (static_cast<const void*>(dest) != values) {
+            std::copy(values, values + count, dest);
+        }
+        m_placedSize += count;
+    }
+
+  public:
+    ColumnBuffer() = default;
+    explicit ColumnBuffer(const bool floatStored) :
+      m_floatStored{floatStored} {}
+
+    bool isFloatStored() const          { return m_floatStored; }
+    bool isPlaced() const               { return m_placedCapacity > 0; }
+    size_t getValueBytes() const {
+        return m_floatStored ? sizeof(float) : sizeof(double);
+    }
+    size_t size() const {
+        if (isPlaced()) { return m_placedSize; }
+        return m_floatStored ? m_floatValues.size() : m_values.size();
+    }
+    bool empty() const                  { return size() == 0; }
+    void reserve(const size_t size) {
+        if (isPlaced())         { return; }
+        if (m_floatStored)      { m_floatValues.reserve(size); }
+        else                    { m_values.reserve(size); }
+    }
+    // Parse into the given memory of the given number of values from now on.
+    void place(void* bgn, const size_t capacity) {
+        release();
+        if (m_floatStored)  { m_placedFloatValues = static_cast<float*>(bgn); }
+        else                { m_placedValues = static_cast<double*>(bgn); }
+        m_placedCapacity = capacity;
+    }
+    // Return an empty buffer placed in the given rows of this placed buffer.
+    ColumnBuffer view(const size_t rowBgn, const size_t rowTotal) const {
+        ColumnBuffer buffer{m_floatStored};
+        buffer.place(m_floatStored
+            ? static_cast<void*>(m_placedFloatValues + rowBgn)
+            : static_cast<void*>(m_placedValues + rowBgn), rowTotal);
+        return buffer;
+    }
+    void addValue(const double value) {
+        if (isPlaced()) {
+            if (m_placedSize == m_placedCapacity) {
+                throw runtime_error(errorDlmFormatIncorrect);
+            }
+            if (m_floatStored)  { m_placedFloatValues[m_placedSize] = value; }
+            else                { m_placedValues[m_placedSize] = value; }
+            ++m_placedSize;
+        }
+        else if (m_floatStored) { m_floatValues.push_back(value); }
+        else                    { m_values.push_back(value); }
+    }
+    // Append the first count values of the other buffer, and release it.
+    void append(ColumnBuffer& other, const size_t count) {
+        if (m_floatStored && other.m_floatStored) {
+            appendValues(other.getFloatValues().data(), count, m_floatValues,
+                m_placedFloatValues);
+        }
+        else if (m_floatStored) {
+            appendValues(other.getValues().data(), count, m_floatValues,
+                m_placedFloatValues);
+        }
+        else if (other.m_floatStored) {
+            appendValues(other.getFloatValues().data(), count, m_values,
+                m_placedValues);
+        }
+        else {
+            appendValues(other.getValues().data(), count, m_values,
+                m_placedValues);
+        }
+        other.release();
+    }
+    // Release the values; those of a placed buffer are left to the arena.
+    void release() {
+        vector<double>().swap(m_values);
+        vector<float>().swap(m_floatValues);
+        m_placedValues = nullptr;
+        m_placedFloatValues = nullptr;
+        m_placedSize = m_placedCapacity = 0;
+    }
+    ColSpan<double> getValues() const {
+        if (isPlaced()) { return {m_placedValues, m_placedSize}; }
+        return ColSpan<double>{m_values};
+    }
+    ColSpan<float> getFloatValues() const {
+        if (isPlaced()) { return {m_placedFloatValues, m_placedSize}; }
+        return ColSpan<float>{m_floatValues};
+    }
+};
+
 //----------------------------------------------------------------------------//
 //*************************** ColData::IntV Class ****************************//
 //----------------------------------------------------------------------------//
 /*
- * Integer vector class for column data.
+ * Integer vector class for column data, which belongs to the table that it is
+ * created in. Whether the values are strictly increasing, and by a uniform
+ * stride, is found as they are loaded, so that the row of a timestep is found
+ * by arithmetic or by binary search instead of a scan of the column.
  */
 class ColData::IntV {
   private:
+    Table&                      m_table;
     const int                   m_id;
     const int                   m_colNo;
     const string                m_colName;
-    vector<int>                 m_data;
-    inline static int           s_total{};
-    inline static set<int>      s_intVColNoSet{};
-    inline static vector<IntV*> s_intVSetP{};
+    vector<int>                 m_values;
+    ColSpan<int>                m_data;
+    bool                        m_increasing{true};
+    bool                        m_uniform{true};
+    long long                   m_stride{0};
 
     IntV() = delete;
     IntV(const IntV&) = delete;
     IntV& operator=(const IntV&) = delete;
 
+    void orderRow(const size_t row);
+
   public:
-    explicit IntV(int colNo, string colName, size_t dataRowTotal);
+    explicit IntV(Table& table, int colNo, string colName,
+        size_t dataRowTotal);
+    explicit IntV(Table& table, int colNo, string colName,
+        ColSpan<int> data);
 
     void addValue(int value);
     static void insertColNoSet(int);
@@ -45,7 +213,7 @@ class ColData::IntV {
     const string& getColName() const;
     int getCol(int colNo) const;
     string& getCol(string& colName) const;
-    const vector<int>& getData() const;
+    const ColSpan<int>& getData() const;
     tuple<bool, size_t, size_t> getTimestepRange() const;
     size_t getRow(int timestepVal) const;
 
@@ -53,58 +221,141 @@ class ColData::IntV {
     static set<int>& getColNoSet();
     static vector<IntV*>& getSetP();
     static IntV* getOneP(const int id);
-    // static IntV* getOnePFromCol(const int inputColNo);
-    // static IntV* getOnePFromCol(const string inputColName);
-    template<typename T>
-    IntV* getOnePFromCol(const T inputCol) {
-        int id{-1};
-        T col{inputCol};
-        for (IntV* iVP : s_intVSetP) {
-            if (inputCol == iVP->getCol(col)) { id = iVP->m_id; }
-        }
-        if (id<0) { throw runtime_error(errorColAbsent); }
-        return s_intVSetP[id];
-    }
+    static IntV* getOnePFromCol(const int inputColNo);
+    static IntV* getOnePFromCol(const string& inputColName);
 };
 
 //----------------------------------------------------------------------------//
 //************************ ColData::DoubleV Class *************************//
 //----------------------------------------------------------------------------//
 /*
- * Double vector class for column data.
+ * Double vector class for column data, which belongs to the table that it is
+ * created in, and whose data is held in the arena of that table. With float
+ * storage, the values are held as float instead, and are widened to double as
+ * they are read. A column with a source is decoded from it into the arena of
+ * its table when its values are first read. A column
+ * that is parsed or decoded keeps the zone statistics of each block of
+ * zoneBlockRows rows, from which the sums over a range of rows are combined,
+ * so that only the rows of the blocks at its edges are read; a column mapped
+ * from the cache is read whole. The extrema over a range of rows are taken
+ * from a sparse table of the extrema of the blocks of extremaBlockRows rows,
+ * which is found when the extrema are first needed, and from the rows of the
+ * blocks at its edges. With prefix sums, the sums over a range of rows are
+ * instead taken from the compensated prefix sums of the powers of the rows,
+ * shifted by the mean of the column, which are found when a sum is first
+ * needed.
  */
 class ColData::DoubleV {
   private:
+    Table&                          m_table;
     const int                       m_id;
     const int                       m_colNo;
     const string                    m_colName;
-    vector<double>                  m_data;
-    inline static int               s_total{};
-    inline static set<int>          s_doubleVColNoSet{};
-    inline static vector<DoubleV*>  s_doubleVSetP{};
+    bool                            m_floatStored;
+    mutable vector<double>          m_values;
+    mutable vector<float>           m_floatValues;
+    mutable ColSpan<double>         m_data;
+    mutable ColSpan<float>          m_floatData;
+    const ColumnSource*             m_sourceP{nullptr};
+    mutable std::once_flag          m_decodedFlag{};
+    mutable vector<ZoneStats>       m_zoneStatsSet{};
+    mutable std::once_flag          m_extremaFlag{};
+    mutable vector<vector<RangeExtrema>> m_extremaTable{};
+    mutable std::once_flag          m_prefixFlag{};
+    mutable double                  m_prefixShift{0.0};
+    mutable vector<PrefixMoments>   m_prefixMomentsSet{};
+    inline static bool              s_floatStorage{false};
+    inline static bool              s_prefixSums{false};
 
     DoubleV() = delete;
     DoubleV(const DoubleV&) = delete;
     DoubleV& operator=(const DoubleV&) = delete;
 
+    void decode() const;
+    void storeData(ColumnBuffer& data) const;
+    template<typename T>
+    void findZoneStats(const ColSpan<T>& data) const;
+    template<typename T>
+    void findExtremaTable(const ColSpan<T>& data) const;
+    template<typename T>
+    RangeExtrema findRangeExtrema(const ColSpan<T>& data, const size_t rowBgn,
+        const size_t rowEnd) const;
+    RangeExtrema findRangeExtrema(const size_t rowBgn,
+        const size_t rowEnd) const;
+    template<typename T>
+    void findPrefixMoments(const ColSpan<T>& data) const;
+    double getShiftedSum(const int power, const size_t rowBgn,
+        const size_t rowEnd) const;
+    template<typename T, typename R, typename Z>
+    double reduceRows(const ColSpan<T>& data, const size_t rowBgn,
+        const size_t rowEnd, double value, R reduceRow, Z reduceZone) const;
+    template<typename T>
+    double getSum(const ColSpan<T>& data, const size_t rowBgn,
+        const size_t rowEnd) const;
+    template<typename T>
+    double getSumOfSquares(const ColSpan<T>& data, const size_t rowBgn,
+        const size_t rowEnd) const;
+    template<typename T>
+    double getSumOfCubes(const ColSpan<T>& data, const size_t rowBgn,
+        const size_t rowEnd) const;
+    template<typename T>
+    double getSumOfSquaresOfDifference(const ColSpan<T>& data,
+        const double diffVal, const size_t rowBgn, const size_t rowEnd) const;
+    template<typename T>
+    CycleData findCycles(const ColSpan<T>& data, const size_t rowBgn,
+        const size_t rowEnd, const double mean, const double minAmplitude,
+        const size_t minRowInterval) const;
+    template<typename T>
+    CycleData findCyclesFirst(const ColSpan<T>& data, const size_t rowBgn,
+        const size_t rowEnd, const double mean, const double minAmplitude,
+        const size_t minRowInterval, const int cycles) const;
+    template<typename T>
+    CycleData findCyclesLast(const ColSpan<T>& data, const size_t rowBgn,
+        const size_t rowEnd, const double mean, const double minAmplitude,
+        const size_t minRowInterval, const int cycles) const;
+
   public:
-    explicit DoubleV(int colNo, string colName, size_t dataRowTotal);
+    explicit DoubleV(Table& table, int colNo, string colName,
+        size_t dataRowTotal);
+    explicit DoubleV(Table& table, int colNo, string colName,
+        ColumnBuffer&& data);
+    explicit DoubleV(Table& table, int colNo, string colName,
+        ColSpan<double> data);
 
     void addValue(double value);
     static void insertColNoSet(int colNo);
+    static void setFloatStorage(const bool floatStorage);
+    static bool getFloatStorage();
+    static void setPrefixSums(const bool prefixSums);
+    void setSource(const ColumnSource* sourceP);
 
     int getId() const;
     int getColNo() const;
     const string& getColName() const;
-    const vector<double>& getData() const;
+    bool isFloatStored() const;
+    const ColSpan<double>& getData() const;     // empty if stored as float
+    size_t getSize() const;
+    double getValue(const size_t row) const;
+    vector<double> copyData() const;
+    // Call the given function with the data span of the column, whether it is
+    // stored as double or as float, and return its result.
+    template<typename F>
+    auto visitData(F&& function) const {
+        decode();
+        return m_floatStored ? function(m_floatData) : function(m_data);
+    }
 
     static int getTotal();
     static set<int>& getColNoSet();
     static vector<DoubleV*>& getSetP();
     static DoubleV* getOneP(const int id);
     static DoubleV* getOnePFromCol(const int inputColNo);
-    static DoubleV* getOnePFromCol(const string inputColName);
+    static DoubleV* getOnePFromCol(const string& inputColName);
 
+    double getMin(const size_t rowBgn, const size_t rowEnd) const;
+    double getMax(const size_t rowBgn, const size_t rowEnd) const;
+    double getAbsMin(const size_t rowBgn, const size_t rowEnd) const;
+    double getAbsMax(const size_t rowBgn, const size_t rowEnd) const;
     double getSum(const size_t rowBgn, const size_t rowEnd) const;
     double getSumOfSquares(const size_t rowBgn, const size_t rowEnd) const;
     double getSumOfCubes(const size_t rowBgn, const size_t rowEnd) const;
@@ -121,4 +372,100 @@ class ColData::DoubleV {
         const size_t minRowInterval, const int cycles) const;
 };
 
+//----------------------------------------------------------------------------//
+//************************ ColData::ColumnArena Class ************************//
+//----------------------------------------------------------------------------//
+/*
+ * Memory of the columns of a table, which is mapped in chunks of at least
+ * arenaChunkBytes bytes and handed out in buffers aligned to cacheAlignment
+ * bytes, and which is unmapped as one unit with the arena. With huge pages,
+ * the chunks are mapped with MAP_HUGETLB if the system has huge pages to spare,
+ * and are otherwise advised to be backed by transparent huge pages.
+ */
+class ColData::ColumnArena {
+  private:
+    inline static bool              s_hugePages{false};
+    vector<tuple<char*, size_t>>    m_chunks{};     // beginning and size
+    char*                           m_chunkBgn{nullptr};    // current chunk
+    size_t                          m_chunkBytes{0};
+    size_t                          m_chunkUsed{0};
+    std::mutex                      m_mutex{};
+
+    ColumnArena(const ColumnArena&) = delete;
+    ColumnArena& operator=(const ColumnArena&) = delete;
+
+    static tuple<char*, size_t> mapChunk(const size_t bytes);
+    void* allocate(const size_t bytes);
+
+  public:
+    explicit ColumnArena() = default;
+    ~ColumnArena();
+
+    static void setHugePages(const bool hugePages);
+
+    // Copy the given values into a buffer of the arena, converting them to T.
+    template<typename T, typename V>
+    ColSpan<T> store(const V& values) {
+        T* bgn{static_cast<T*>(allocate(values.size()*sizeof(T)))};
+        std::transform(values.cbegin(), values.cend(), bgn,
+            [](const auto value) { return static_cast<T>(value); });
+        return ColSpan<T>{bgn, values.size()};
+    }
+    void place(ColumnBuffer& buffer, const size_t rowTotal);
+};
+
+//----------------------------------------------------------------------------//
+//*************************** ColData::Table Class ***************************//
+//----------------------------------------------------------------------------//
+/*
+ * Columns of one loaded input, which the table owns and deletes with itself,
+ * along with the arena that holds their data and the sources that any lazy
+ * columns are decoded from.
+ * The integer and the double columns are kept in the order that they were
+ * created, and each is found from its column number or its name through a
+ * hash map. Each column and source is given its table when it is created, and
+ * keeps its data in that table whichever table is current. The loaders create
+ * the columns in the current table, which is also the table that the static
+ * IntV and DoubleV functions look in, so that several tables can be kept side
+ * by side by switching the current one.
+ */
+class ColData::Table {
+  private:
+    inline static Table*            s_currentP{nullptr};
+    vector<IntV*>                   m_intVSetP{};
+    vector<DoubleV*>                m_doubleVSetP{};
+    set<int>                        m_intColNoSet{};
+    set<int>                        m_doubleColNoSet{};
+    unordered_map<int, IntV*>       m_intVColNoMap{};
+    unordered_map<string, IntV*>    m_intVColNameMap{};
+    unordered_map<int, DoubleV*>    m_doubleVColNoMap{};
+    unordered_map<string, DoubleV*> m_doubleVColNameMap{};
+    ColumnArena                     m_arena{};
+    vector<ColumnSource*>           m_sourceSetP{};
+
+    Table(const Table&) = delete;
+    Table& operator=(const Table&) = delete;
+
+  public:
+    explicit Table() = default;
+    ~Table();
+
+    static Table& getCurrent();
+    static void setCurrent(Table& table);
+
+    void addColumn(IntV* iVP);
+    void addColumn(DoubleV* dVP);
+    void addSource(ColumnSource* sourceP);
+
+    set<int>& getIntColNoSet();
+    set<int>& getDoubleColNoSet();
+    vector<IntV*>& getIntVSetP();
+    vector<DoubleV*>& getDoubleVSetP();
+    ColumnArena& getArena();
+    IntV* findIntV(const int colNo) const;
+    IntV* findIntV(const string& colName) const;
+    DoubleV* findDoubleV(const int colNo) const;
+    DoubleV* findDoubleV(const string& colName) const;
+};
+
 #endif
\ No newline at end of file
@@ -103,8 +103,41 @@ errorFourierArgumetInvalid{"An invalid argument has been specified for the FFT "
 errorFourierColNameInvalid{"The column name specified for the FFT option is "
     "invalid."},
 errorFourierColMissing{"The column name for the FFT option is missing."},
+errorThreadsInvalid{"Requested number of threads is invalid."},
+errorReadAheadInvalid{"Requested read-ahead block size is invalid."},
+errorPrecisionInvalid{"Requested precision is invalid. Please use \"float\" "
+    "or \"double\"."},
+errorStreamUnsupported{"The FFT, --print-data and --file-data options need the "
+    "column data, which is not stored with the --stream option."},
+errorStreamCompressed{"A compressed input file cannot be memory-mapped for "
+    "the --stream option. Please load it without --stream."},
+errorStreamCycleLast{"The last cycles cannot be found with the --stream "
+    "option, since the data is read only forwards. Please use \"first\" or "
+    "load the file without --stream."},
+errorStreamTimestepInvalid{"The timestep column has a value that is not a "
+    "non-negative integer after the first row. Please load the file without "
+    "--stream to use it as a data column."},
+errorFollowIntervalInvalid{"Requested interval for following the input file is "
+    "invalid."},
+errorMergeColumns{"The input files to be merged do not have the same "
+    "columns."},
+errorMergeCompressed{"A compressed input file cannot be merged with other "
+    "input files. Please decompress it first."},
+errorMergeUnsupported{"Several input files cannot be streamed, indexed or "
+    "cached, or read from the standard input. Please load them without "
+    "--stream, --follow, --index or --cache."},
+errorStdinUnsupported{"The standard input cannot be memory-mapped, indexed or "
+    "cached. Please read it without --stream, --follow, --index or --cache."},
+errorFollowTruncated{"The followed input file has been truncated or removed."},
 errorInputFile{"Input file could not be opened. It may be being used by "
     "another program."},
+errorFileMap{"Input file could not be memory-mapped."},
+errorDecompress{"Input file could not be decompressed. It may be truncated or "
+    "corrupt."},
+errorZstdUnsupported{"Zstandard-compressed input is not supported by this "
+    "build. Please build the program with zstd, as given in the Makefile."},
+errorIndexFile{"The index file does not match the input file. Please delete "
+    "it so that it is built again."},
 errorOutputFile{"Output file could not be opened."},
 errorOutputFileNameEmpty{"An output file has been requested but the output "
     "file name is empty."},
@@ -0,0 +1,1018 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        fileMap.cpp
+ * @brief       Memory-map the input file and load the column data from it in a
+ *              single forward scan.
+ */
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "namespaces.h"
+#include "colData.h"
+#include "fileMap.h"
+#include "lazy.h"
+#include "tokenizer.h"
+#include "scanner.h"
+#include "index.h"
+#include "errorMsgs.h"
+
+using namespace ColData;
+
+//----------------------------------------------------------------------------//
+//************************ ColData::MappedFile Class *************************//
+//----------------------------------------------------------------------------//
+MappedFile::MappedFile(const string& fileName) {
+    m_fd = open(fileName.c_str(), O_RDONLY);
+    if (m_fd < 0) { throw runtime_error(errorInputFile); }
+
+    struct stat fileStat;
+    if (fstat(m_fd, &fileStat) != 0) {
+        close(m_fd);
+        throw runtime_error(errorInputFile);
+    }
+    m_size = static_cast<size_t>(fileStat.st_size);
+    if (m_size > 0) {
+        void* addr{mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0)};
+        if (addr == MAP_FAILED) {
+            close(m_fd);
+            throw runtime_error(errorFileMap);
+        }
+        madvise(addr, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(addr);
+    }
+}
+MappedFile::~MappedFile() {
+    if (m_data) { munmap(const_cast<char*>(m_data), m_size); }
+    if (m_fd >= 0) { close(m_fd); }
+}
+
+const char* MappedFile::getData() const { return m_data; }
+size_t MappedFile::getSize() const      { return m_size; }
+stringV MappedFile::getView() const     { return {m_data, m_size}; }
+
+//----------------------------------------------------------------------------//
+//********************** ColData::FixedWidthRows Class ***********************//
+//----------------------------------------------------------------------------//
+FixedWidthRows::FixedWidthRows(const char* bgn, const char* end,
+        const string& dlm, const Delimitation dataDlmType)
+        : m_bgn{bgn}, m_end{end} {
+    if (dataDlmType != Delimitation::spaced || bgn >= end) { return; }
+    const char* eol{
+        static_cast<const char*>(std::memchr(bgn, '\n', end - bgn))
+    };
+    if (!eol) { return; }
+    vector<stringV> fields;
+    RowScanner{bgn, eol + 1, dlm, dataDlmType}.nextRow(fields);
+    if (fields.empty()) { return; }
+    for (stringV field : fields) {
+        m_fieldBgns.push_back(field.data() - bgn);
+        m_fieldEnds.push_back(field.data() + field.length() - bgn);
+    }
+
+    // The last row may be without its newline
+    const size_t rowLength{static_cast<size_t>(eol + 1 - bgn)};
+    const size_t dataBytes{static_cast<size_t>(end - bgn)};
+    const size_t rowTotal{(dataBytes + 1)/rowLength};
+    if (rowTotal*rowLength != dataBytes
+            && rowTotal*rowLength != dataBytes + 1) {
+        return;
+    }
+    m_rowLength = rowLength;
+    const size_t sampleRowTotal{std::min(rowTotal, s_sampleRowTotal)};
+    for (size_t row=0; row<=sampleRowTotal; ++row) {
+        const size_t sampleRow{row < sampleRowTotal ? row : rowTotal - 1};
+        if (!readFields(bgn + sampleRow*rowLength, end, fields)) {
+            m_rowLength = 0;
+            return;
+        }
+    }
+    m_rowTotal = rowTotal;
+}
+
+bool FixedWidthRows::isFound() const        { return m_rowLength > 0; }
+size_t FixedWidthRows::getRowLength() const { return m_rowLength; }
+size_t FixedWidthRows::getRowTotal() const  { return m_rowTotal; }
+
+/*
+ * Find the beginning of the given row, or the end if there is no such row.
+ */
+const char* FixedWidthRows::findRow(const size_t row) const {
+    return row < m_rowTotal ? m_bgn + row*m_rowLength : m_end;
+}
+
+/*
+ * Check if the row that begins at the given pointer has the length of the
+ * layout and ends before the given end.
+ */
+bool FixedWidthRows::fitsRow(const char* row, const char* end) const {
+    const size_t rowBytes{static_cast<size_t>(end - row)};
+    const size_t lineLength{m_rowLength - 1};
+    return rowBytes > lineLength ? row[lineLength] == '\n'
+        : rowBytes == lineLength && end == m_end;
+}
+
+/*
+ * Slice the given field of the row that begins at the given pointer, allowing
+ * it to grow or shrink to the left within the spaces before it, as the
+ * right-aligned numbers do. Return false if it does not fit the layout.
+ */
+bool FixedWidthRows::sliceField(const char* row, const size_t f,
+        stringV& field) const {
+    const char* slotBgn{f > 0 ? row + m_fieldEnds[f-1] : row};
+    const char* fieldBgn{row + m_fieldBgns[f]};
+    const char* fieldEnd{row + m_fieldEnds[f]};
+    if (fieldEnd[-1] == ' ') { return false; }
+    while (*fieldBgn == ' ') { ++fieldBgn; }
+    while (fieldBgn > slotBgn && fieldBgn[-1] != ' ') { --fieldBgn; }
+    if (f > 0 && fieldBgn == slotBgn) { return false; }
+    for (const char* pos{slotBgn}; pos < fieldBgn; ++pos) {
+        if (*pos != ' ') { return false; }
+    }
+    field = stringV(fieldBgn, fieldEnd - fieldBgn);
+    return true;
+}
+
+/*
+ * Slice the fields of the row that begins at the given pointer. Return false
+ * if the row does not end before the given end or does not fit the layout.
+ */
+bool FixedWidthRows::readFields(const char* row, const char* end,
+        vector<stringV>& fields) const {
+    if (!fitsRow(row, end)) { return false; }
+    fields.clear();
+    stringV field;
+    for (size_t f=0; f<m_fieldEnds.size(); ++f) {
+        if (!sliceField(row, f, field)) { return false; }
+        fields.push_back(field);
+    }
+    const char* slotBgn{
+        m_fieldEnds.empty() ? row : row + m_fieldEnds.back()
+    };
+    for (const char* pos{slotBgn}; pos < row + m_rowLength - 1; ++pos) {
+        if (!FieldTokenizer::isSpace(*pos)) { return false; }
+    }
+    return true;
+}
+
+/*
+ * Slice only the given field of the row that begins at the given pointer, like
+ * FixedWidthRows::readFields().
+ */
+bool FixedWidthRows::readField(const char* row, const char* end,
+        const int colNo, stringV& field) const {
+    return static_cast<size_t>(colNo) < m_fieldEnds.size()
+        && fitsRow(row, end) && sliceField(row, colNo, field);
+}
+
+/*
+ * Read the timestep of the given row. Return false if the row does not fit the
+ * layout or its field is not a non-negative integer.
+ */
+bool FixedWidthRows::readTimestep(const size_t row, const int timestepColNo,
+        size_t& timestep) const {
+    vector<stringV> fields;
+    int value;
+    if (!readFields(findRow(row), m_end, fields)
+            || static_cast<size_t>(timestepColNo) >= fields.size()
+            || !FieldTokenizer::isDigits(fields[timestepColNo])
+            || !FieldTokenizer::toNumber(fields[timestepColNo], value)) {
+        return false;
+    }
+    timestep = value;
+    return true;
+}
+
+/*
+ * Find the first row from the given row on whose timestep is not less than the
+ * given timestep, or the row total if there is none, by a binary search over
+ * the rows that assumes that the timesteps increase down the rows. Each
+ * timestep read must lie between those read above and below it. The bytes of
+ * the rows read are added to the given count. Return false if a timestep
+ * cannot be read or is out of order.
+ */
+bool FixedWidthRows::findTimestepRow(const size_t timestep,
+        const int timestepColNo, size_t lo, size_t& row,
+        size_t& bytesScanned) const {
+    size_t hi{m_rowTotal}, value;
+    size_t loValue{0}, hiValue{std::numeric_limits<size_t>::max()};
+    bool loFound{false};
+    while (lo < hi) {
+        const size_t mid{lo + (hi - lo)/2};
+        bytesScanned += m_rowLength;
+        if (!readTimestep(mid, timestepColNo, value)
+                || (loFound && value <= loValue) || value >= hiValue) {
+            return false;
+        }
+        if (value >= timestep) {
+            hi = mid;
+            hiValue = value;
+        }
+        else {
+            lo = mid + 1;
+            loValue = value;
+            loFound = true;
+        }
+    }
+    row = lo;
+    return true;
+}
+
+/*
+ * Find the window of rows to be loaded from the range of rows or timesteps of
+ * the load options like ColData::findMappedWindow(), but with the rows reached
+ * by their offsets, so that no row is counted and the rows of the file are
+ * known; only the rows read by the search are scanned. If the window cannot be
+ * found, the whole data is returned.
+ */
+tuple<const char*, const char*> FixedWidthRows::findWindow(
+        const int timestepColNo, const LoadOptions& loadOptions,
+        LoadStats& loadStats) const {
+    size_t rowBgn{0}, rowEnd{m_rowTotal}, bytesScanned{0};
+    if (loadOptions.rowBgnDefined || loadOptions.rowEndDefined) {
+        if (loadOptions.rowBgnDefined) { rowBgn = loadOptions.rowBgn; }
+        if (loadOptions.rowEndDefined) {
+            rowEnd = std::min(loadOptions.rowEnd, m_rowTotal - 1) + 1;
+        }
+        if (loadOptions.rowBgnDefined && loadOptions.rowEndDefined
+                && loadOptions.rowBgn > loadOptions.rowEnd) {
+            rowBgn = loadOptions.rowEnd;
+            rowEnd = std::min(loadOptions.rowBgn, m_rowTotal - 1) + 1;
+        }
+    }
+    else if (timestepColNo >= 0) {
+        size_t timestepBgn{loadOptions.timestepBgn};
+        size_t timestepEnd{loadOptions.timestepEnd};
+        if (loadOptions.timestepBgnDefined && loadOptions.timestepEndDefined
+                && timestepBgn > timestepEnd) {
+            std::swap(timestepBgn, timestepEnd);
+        }
+        if ((loadOptions.timestepBgnDefined && !findTimestepRow(timestepBgn,
+                    timestepColNo, 0, rowBgn, bytesScanned))
+                || (loadOptions.timestepEndDefined
+                    && !findTimestepRow(timestepEnd + 1, timestepColNo,
+                        rowBgn, rowEnd, bytesScanned))) {
+            return {m_bgn, m_end};
+        }
+    }
+    else {
+        return {m_bgn, m_end};
+    }
+    if (rowBgn >= rowEnd) { return {m_bgn, m_end}; }
+    loadStats.rowOffset = rowBgn;
+    loadStats.fileRowTotal = m_rowTotal;
+    loadStats.windowed = true;
+    loadStats.partial = rowEnd < m_rowTotal;
+    loadStats.bytesScanned = bytesScanned;
+    return {findRow(rowBgn), findRow(rowEnd)};
+}
+
+//----------------------------------------------------------------------------//
+//********************** Single-pass mapped data loading *********************//
+//----------------------------------------------------------------------------//
+/*
+ * Map the file and load it in one forward scan: the header is found from the
+ * first lines, and the rows are counted and the columns are classified and
+ * populated together, so that no part of the file is read more than once. The
+ * data section is split among the requested number of threads. If a window of
+ * rows is requested, only the rows of the window are parsed. With an index of
+ * the file, its header, data type and timestep column are taken from the
+ * index instead. Return the same variables as ColData::loadData().
+ */
+const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+        ColData::loadMappedData(const string& fileName, const string& dlm,
+            const LoadOptions& loadOptions) {
+    // Map file --------------------------------------------------------------//
+    const std::shared_ptr<const MappedFile> mapP{
+        std::make_shared<const MappedFile>(fileName)
+    };
+    const MappedFile& map{*mapP};
+    cout << "File found. Program initiated." << flush;
+
+    // Process the header ----------------------------------------------------//
+    const RowIndex* rowIndexP{loadOptions.rowIndexP};
+    stringV headerLine, dataLine;
+    size_t dataOffset;
+    if (rowIndexP) {
+        headerLine = findMappedLine(map, rowIndexP->getHeaderOffset());
+        dataOffset = rowIndexP->getDataOffset();
+        dataLine = findMappedLine(map, dataOffset);
+    }
+    else {
+        tie(headerLine, dataLine, dataOffset) =
+            findMappedLines(map.getView(), dlm);
+    }
+
+    string headerStr;
+    Delimitation headerDlmType;
+    tie(headerStr, headerDlmType) = parseHeaderLine(string{headerLine}, dlm);
+
+    int dataColTotal;
+    vector<string> colNames;
+    tie(dataColTotal, colNames) =
+        identifyColumnHeaders(headerStr, dlm, headerDlmType);
+
+    if (rowIndexP && rowIndexP->getDataColTotal() != dataColTotal) {
+        throw runtime_error(errorIndexFile);
+    }
+    vector<bool> intColCandidates(dataColTotal, false);
+    if (rowIndexP) {
+        if (rowIndexP->getTimestepColNo() >= 0) {
+            intColCandidates[rowIndexP->getTimestepColNo()] = true;
+        }
+    }
+    const Delimitation dataDlmType{
+        rowIndexP ? rowIndexP->getDataDlmType() : parseColumnData(dataLine, dlm)
+    };
+    const char* dataBgn{map.getData() + dataOffset};
+    const char* dataEnd{map.getData() + map.getSize()};
+    if (!rowIndexP) {
+        intColCandidates = classifyMappedColumns(dataBgn, dataEnd, dlm,
+            dataDlmType, dataColTotal,
+            findTimestepColCandidates(dataColTotal, colNames));
+    }
+    const vector<bool> selectedCols{selectColumns(colNames, loadOptions)};
+    vector<bool> parsedCols(dataColTotal);
+    for (int c=0; c<dataColTotal; ++c) {
+        parsedCols[c] = intColCandidates[c]
+            || (selectedCols[c] && !loadOptions.lazy);
+    }
+
+    // Find the window of rows --------------------------------------------//
+    // The timesteps are searched in halves unless the index records that they
+    // do not increase down the rows, in which case the whole data is loaded,
+    // so that the timestep range is checked as usual. Without an index, only
+    // the rows read by the search and the rows of the window are checked.
+    LoadStats loadStats{map.getSize(), map.getSize()};
+    const FixedWidthRows fixedRows{dataBgn, dataEnd, dlm, dataDlmType};
+    if (loadOptions.windowed) {
+        int timestepColNo{static_cast<int>(
+            std::find(intColCandidates.cbegin(), intColCandidates.cend(), true)
+            - intColCandidates.cbegin())
+        };
+        if (timestepColNo == dataColTotal) { timestepColNo = -1; }
+        const bool timestepWindowed{
+            !loadOptions.rowBgnDefined && !loadOptions.rowEndDefined
+        };
+        if (!timestepWindowed || !rowIndexP
+                || get<0>(rowIndexP->getTimestepRange())) {
+            tie(dataBgn, dataEnd) = fixedRows.isFound()
+                ? fixedRows.findWindow(timestepColNo, loadOptions, loadStats)
+                : findMappedWindow(dataBgn, dataEnd, dlm, dataDlmType,
+                    timestepColNo, loadOptions, loadStats);
+        }
+        if (loadStats.windowed) {
+            loadStats.bytesScanned += dataOffset + (dataEnd - dataBgn);
+        }
+    }
+
+    // Process and store the data --------------------------------------------//
+    cout << "\rIn progress: Parsing column data..." << flush;
+    vector<ColumnBuffer> colData{createColumnBuffers(intColCandidates)};
+    const size_t dataRowTotal{
+        parseMappedChunks(dataBgn, dataEnd, dlm, dataDlmType, dataColTotal,
+            &Table::getCurrent().getArena(), loadOptions.threads,
+            fixedRows.isFound() ? &fixedRows : nullptr, parsedCols, colData,
+            intColCandidates)
+    };
+    if (dataRowTotal == 0) { throw runtime_error(errorDlmFormatIncorrect); }
+
+    cout << "\rIn progress: Processing column data..." << flush;
+    storeMappedColumns(colNames, colData, intColCandidates, selectedCols);
+    if (loadOptions.lazy) {
+        vector<bool> lazyCols(dataColTotal);
+        for (int c=0; c<dataColTotal; ++c) {
+            lazyCols[c] = selectedCols[c] && !parsedCols[c];
+        }
+        ColumnSource* sourceP{new ColumnSource(Table::getCurrent(), mapP,
+            dataBgn, dataEnd, dlm, dataDlmType, dataRowTotal)};
+        sourceP->createColumns(lazyCols);
+    }
+    cout << '\r' << string(38, ' ') << "\n" << flush;
+
+    IntV* dataTimestepIVP{nullptr};
+    if (!IntV::getSetP().empty()) {
+        dataTimestepIVP = IntV::getOneP(0);
+    }
+    // The timestep range of a window spans the file, taking the timesteps to
+    // be consistent outside the window if they are inside it
+    size_t timestepFirst, timestepLast;
+    if (loadStats.windowed && rowIndexP) {
+        loadStats.fileRowTotal = rowIndexP->getDataRowTotal();
+        if (dataTimestepIVP) {
+            loadStats.timestepRange = rowIndexP->getTimestepRange();
+        }
+    }
+    else if (loadStats.windowed && dataTimestepIVP
+            && readMappedTimestep(dataLine, dlm, dataDlmType,
+                dataTimestepIVP->getColNo(), timestepFirst)
+            && readMappedTimestep(findMappedLastLine(map.getData() + dataOffset,
+                    map.getData() + map.getSize()),
+                dlm, dataDlmType, dataTimestepIVP->getColNo(), timestepLast)) {
+        loadStats.timestepRange = {
+            get<0>(dataTimestepIVP->getTimestepRange()),
+            timestepFirst, timestepLast
+        };
+    }
+
+    return {dataDlmType, dataColTotal, dataRowTotal, dataTimestepIVP,
+            DoubleV::getSetP(), loadStats};
+}
+
+/*
+ * Find the time of last modification of the file, for checking whether the
+ * files kept next to it still describe it.
+ */
+int64_t ColData::findFileTime(const string& fileName) {
+    return static_cast<int64_t>(std::filesystem::last_write_time(fileName)
+        .time_since_epoch().count());
+}
+
+/*
+ * Check if the line is empty or has only whitespace.
+ */
+bool ColData::isBlankLine(stringV line) {
+    return all_of(line.begin(), line.end(),
+        [](unsigned char c) { return isspace(c); });
+}
+
+/*
+ * Find the line that begins at the given offset of the mapped file.
+ */
+stringV ColData::findMappedLine(const MappedFile& map, const size_t offset) {
+    const stringV fileView{map.getView()};
+    if (offset >= fileView.length()) { throw runtime_error(errorIndexFile); }
+    size_t eol{fileView.find('\n', offset)};
+    if (eol == stringV::npos) { eol = fileView.length(); }
+    return fileView.substr(offset, eol - offset);
+}
+
+/*
+ * Find the header line and the first data line of the mapped file, or of the
+ * first lines of a file, and return them along with the offset of the first
+ * data line.
+ */
+tuple<stringV, stringV, size_t> ColData::findMappedLines(stringV fileView,
+        const string& dlm) {
+    stringV headerLine, dataLine;
+    size_t pos{0}, dataOffset{0};
+    bool headerFound{false}, dataFound{false};
+
+    while (pos < fileView.length()) {
+        size_t eol{fileView.find('\n', pos)};
+        if (eol == stringV::npos) { eol = fileView.length(); }
+        const stringV line{fileView.substr(pos, eol - pos)};
+        if (!isBlankLine(line)) {
+            if (!isNumberLine(line, dlm)) {
+                headerLine = line;
+                headerFound = true;
+            }
+            else {
+                dataLine = line;
+                dataOffset = pos;
+                dataFound = true;
+                break;
+            }
+        }
+        pos = eol + 1;
+    }
+    if (!headerFound) { throw runtime_error(errorNoHeader); }
+    if (!dataFound) { throw runtime_error(errorDlmFormatIncorrect); }
+    return {headerLine, dataLine, dataOffset};
+}
+
+/*
+ * Narrow the timestep column candidates down to the integer columns from the
+ * same sample of the mapped data as ColData::classifyColumns(), and return the
+ * remaining candidates by their index.
+ */
+vector<bool> ColData::classifyMappedColumns(const char* bgn, const char* end,
+        const string& dlm, const Delimitation dataDlmType,
+        const int dataColTotal, const set<int>& timestepColCandidates) {
+    vector<bool> intColCandidates(dataColTotal, false);
+    for (int c : timestepColCandidates) { intColCandidates[c] = true; }
+
+    const size_t dataBytes{static_cast<size_t>(end - bgn)};
+    vector<size_t> blockBgns{0};
+    size_t blockBytes{dataBytes};
+    if (dataBytes > 3*classifySampleBytes) {
+        blockBgns.push_back((dataBytes - classifySampleBytes)/2);
+        blockBgns.push_back(dataBytes - classifySampleBytes);
+        blockBytes = classifySampleBytes;
+    }
+
+    stringV field;
+    for (const size_t blockBgn : blockBgns) {
+        const char* blockEnd{bgn + blockBgn + blockBytes};
+        for (const char* row{findMappedRow(bgn, end, bgn + blockBgn)};
+                row < blockEnd && row < end;
+                row = findMappedRow(bgn, end, row + 1)) {
+            const char* eol{
+                static_cast<const char*>(std::memchr(row, '\n', end - row))
+            };
+            FieldTokenizer tokenizer{stringV(row, (eol ? eol : end) - row),
+                dlm, dataDlmType};
+            for (int c=0; c<dataColTotal && tokenizer.next(field); ++c) {
+                if (intColCandidates[c] && !FieldTokenizer::isDigits(field)) {
+                    intColCandidates[c] = false;
+                }
+            }
+        }
+    }
+    return intColCandidates;
+}
+
+/*
+ * Append each field of the parsed columns of a row to its column, dropping any
+ * integer column candidate whose field is not a non-negative integer, so that
+ * a candidate is demoted by the row that rules it out without a rescan. The
+ * fixed formats of the fields are found from the first row.
+ */
+void ColData::parseDataRow(const vector<stringV>& fields,
+        const int dataColTotal, const vector<bool>& parsedCols,
+        vector<FixedFormat>& formats, vector<ColumnBuffer>& colData,
+        vector<bool>& intColCandidates) {
+    if (fields.size() < static_cast<size_t>(dataColTotal)) {
+        throw runtime_error(errorDlmFormatIncorrect);
+    }
+    if (formats.empty()) {
+        for (int c=0; c<dataColTotal; ++c) {
+            formats.emplace_back(fields[c]);
+        }
+    }
+    for (int c=0; c<dataColTotal; ++c) {
+        if (!parsedCols[c]) { continue; }
+        const stringV field{fields[c]};
+        double value;
+        if (!formats[c].toNumber(field, value)
+                && !FieldTokenizer::toNumber(field, value)) {
+            throw runtime_error(errorDataFormatIncorrect);
+        }
+        if (intColCandidates[c]
+                && (value > numeric_limits<int>::max()
+                    || !FieldTokenizer::isDigits(field))) {
+            intColCandidates[c] = false;
+        }
+        colData[c].addValue(value);
+    }
+}
+
+/*
+ * Parse the data lines between the given pointers, appending each field of the
+ * parsed columns to its column and dropping any integer column candidate that
+ * has a field which is not a non-negative integer. The fields of the other
+ * columns are skipped. Return the number of rows parsed.
+ */
+size_t ColData::parseMappedLines(const char* bgn, const char* end,
+        const string& dlm, const Delimitation dataDlmType,
+        const int dataColTotal, const vector<bool>& parsedCols,
+        vector<ColumnBuffer>& colData, vector<bool>& intColCandidates) {
+    size_t dataRowTotal{0};
+    RowScanner scanner{bgn, end, dlm, dataDlmType};
+    vector<stringV> fields;
+    vector<FixedFormat> formats;
+
+    while (scanner.nextRow(fields)) {
+        parseDataRow(fields, dataColTotal, parsedCols, formats, colData,
+            intColCandidates);
+        ++dataRowTotal;
+    }
+    return dataRowTotal;
+}
+
+/*
+ * Parse the fixed-width rows between the given pointers like
+ * ColData::parseMappedLines(), slicing the fields of each row at their offsets
+ * instead of scanning for them. From the first row that does not fit the
+ * layout on, the lines are scanned as usual.
+ */
+size_t ColData::parseFixedLines(const FixedWidthRows& fixedRows,
+        const char* bgn, const char* end, const string& dlm,
+        const Delimitation dataDlmType, const int dataColTotal,
+        const vector<bool>& parsedCols, vector<ColumnBuffer>& colData,
+        vector<bool>& intColCandidates) {
+    size_t dataRowTotal{0};
+    vector<stringV> fields;
+    vector<FixedFormat> formats;
+
+    const char* row{bgn};
+    while (row < end && fixedRows.readFields(row, end, fields)) {
+        parseDataRow(fields, dataColTotal, parsedCols, formats, colData,
+            intColCandidates);
+        ++dataRowTotal;
+        row += std::min<size_t>(fixedRows.getRowLength(), end - row);
+    }
+    return dataRowTotal + parseMappedLines(row, end, dlm, dataDlmType,
+        dataColTotal, parsedCols, colData, intColCandidates);
+}
+
+/*
+ * Split the lines between the given pointers into chunks of about equal size
+ * and return the chunk boundaries, each of which is the start of a line.
+ */
+vector<const char*> ColData::splitMappedLines(const char* bgn,
+        const char* end, const unsigned chunkTotal) {
+    const size_t chunkBytes{static_cast<size_t>(end - bgn)/chunkTotal};
+    vector<const char*> bounds{bgn};
+    for (unsigned chunk=1; chunk<chunkTotal; ++chunk) {
+        const char* pos{std::max(bounds.back(), bgn + chunk*chunkBytes)};
+        const char* eol{
+            static_cast<const char*>(std::memchr(pos, '\n', end - pos))
+        };
+        bounds.push_back(eol ? eol + 1 : end);
+    }
+    bounds.push_back(end);
+    return bounds;
+}
+
+/*
+ * Run the given function for each of the given number of chunks, on a thread
+ * of its own unless there is only one chunk, and rethrow the first error.
+ */
+template<typename F>
+static void runChunks(const unsigned chunkTotal, F function) {
+    if (chunkTotal == 1) {
+        function(0u);
+        return;
+    }
+    vector<std::exception_ptr> errors(chunkTotal);
+    vector<std::thread> workers;
+    for (unsigned t=0; t<chunkTotal; ++t) {
+        workers.emplace_back([&, t]() {
+            try { function(t); }
+            catch (...) { errors[t] = std::current_exception(); }
+        });
+    }
+    for (std::thread& worker : workers) { worker.join(); }
+    for (const std::exception_ptr& error : errors) {
+        if (error) { std::rethrow_exception(error); }
+    }
+}
+
+/*
+ * Parse the data lines between the given pointers on the given number of
+ * threads. The rows of each chunk of lines are counted first, so that the
+ * parsed columns are reserved to their size. With an arena, the parsed columns
+ * other than the integer column candidates are placed in it, and each thread
+ * parses its chunk straight into its own rows of them. The candidates are
+ * parsed into thread-local column segments, which are then stitched in order
+ * into the columns, with the columns shared out among the threads. Return the
+ * number of rows parsed.
+ */
+size_t ColData::parseMappedChunks(const char* bgn, const char* end,
+        const string& dlm, const Delimitation dataDlmType,
+        const int dataColTotal, ColumnArena* arenaP, const unsigned threads,
+        const FixedWidthRows* fixedRowsP, const vector<bool>& parsedCols,
+        vector<ColumnBuffer>& colData, vector<bool>& intColCandidates) {
+    const size_t dataBytes{static_cast<size_t>(end - bgn)};
+    const unsigned chunkTotal{
+        static_cast<unsigned>(std::min<size_t>(
+            std::max(threads, 1u), dataBytes/minChunkBytes + 1))
+    };
+    const vector<const char*> bounds{splitMappedLines(bgn, end, chunkTotal)};
+    auto parseChunk = [&](const unsigned t, vector<ColumnBuffer>& chunkData,
+            vector<bool>& chunkCandidates) {
+        return fixedRowsP
+            ? parseFixedLines(*fixedRowsP, bounds[t], bounds[t+1], dlm,
+                dataDlmType, dataColTotal, parsedCols, chunkData,
+                chunkCandidates)
+            : parseMappedLines(bounds[t], bounds[t+1], dlm, dataDlmType,
+                dataColTotal, parsedCols, chunkData, chunkCandidates);
+    };
+
+    // Count the rows and reserve the columns --------------------------------//
+    vector<size_t> chunkRows(chunkTotal, 0);
+    runChunks(chunkTotal, [&](const unsigned t) {
+        RowCounter rowCounter;
+        rowCounter.count(bounds[t], bounds[t+1]);
+        chunkRows[t] = rowCounter.getRowTotal();
+    });
+    const size_t rowTotal{
+        accumulate(chunkRows.cbegin(), chunkRows.cend(), size_t{0})
+    };
+    for (int c=0; c<dataColTotal; ++c) {
+        if (!parsedCols[c]) { continue; }
+        if (arenaP && !intColCandidates[c]) {
+            arenaP->place(colData[c], rowTotal);
+        }
+        else if (chunkTotal == 1) { colData[c].reserve(rowTotal); }
+    }
+    if (chunkTotal == 1) { return parseChunk(0, colData, intColCandidates); }
+
+    // Parse the chunks into segments ----------------------------------------//
+    vector<vector<ColumnBuffer>> segments(chunkTotal);
+    size_t rowBgn{0};
+    for (unsigned t=0; t<chunkTotal; ++t) {
+        for (int c=0; c<dataColTotal; ++c) {
+            segments[t].push_back(colData[c].isPlaced()
+                ? colData[c].view(rowBgn, chunkRows[t])
+                : ColumnBuffer(colData[c].isFloatStored()));
+            if (parsedCols[c]) { segments[t][c].reserve(chunkRows[t]); }
+        }
+        rowBgn += chunkRows[t];
+    }
+    vector<vector<bool>> segmentCandidates(chunkTotal, intColCandidates);
+    vector<size_t> segmentRows(chunkTotal, 0);
+    runChunks(chunkTotal, [&](const unsigned t) {
+        segmentRows[t] = parseChunk(t, segments[t], segmentCandidates[t]);
+    });
+
+    // Stitch the segments ---------------------------------------------------//
+    const size_t dataRowTotal{
+        accumulate(segmentRows.cbegin(), segmentRows.cend(), size_t{0})
+    };
+    for (int c=0; c<dataColTotal; ++c) {
+        for (const vector<bool>& candidates : segmentCandidates) {
+            if (!candidates[c]) { intColCandidates[c] = false; }
+        }
+    }
+    runChunks(chunkTotal, [&](const unsigned t) {
+        for (int c=static_cast<int>(t); c<dataColTotal; c+=chunkTotal) {
+            if (!parsedCols[c]) { continue; }
+            colData[c].reserve(dataRowTotal);
+            for (vector<ColumnBuffer>& segment : segments) {
+                colData[c].append(segment[c], segment[c].size());
+            }
+        }
+    });
+    return dataRowTotal;
+}
+
+//----------------------------------------------------------------------------//
+//************************* Windows of the mapped rows ***********************//
+//----------------------------------------------------------------------------//
+/*
+ * Read the timestep from its column in the given line. Return false if the
+ * field is missing or is not a non-negative integer.
+ */
+bool ColData::readMappedTimestep(stringV line, const string& dlm,
+        const Delimitation dataDlmType, const int timestepColNo,
+        size_t& timestep) {
+    FieldTokenizer tokenizer{line, dlm, dataDlmType};
+    stringV field;
+    for (int c=0; c<=timestepColNo; ++c) {
+        if (!tokenizer.next(field)) { return false; }
+    }
+    int value;
+    if (!FieldTokenizer::isDigits(field)
+            || !FieldTokenizer::toNumber(field, value)) {
+        return false;
+    }
+    timestep = value;
+    return true;
+}
+
+/*
+ * Find the beginning of the first line that is not blank and begins at or after
+ * the given position, or the end if there is none.
+ */
+const char* ColData::findMappedRow(const char* bgn, const char* end,
+        const char* pos) {
+    if (pos > bgn && pos[-1] != '\n') {
+        const char* eol{
+            static_cast<const char*>(std::memchr(pos, '\n', end - pos))
+        };
+        pos = eol ? eol + 1 : end;
+    }
+    while (pos < end) {
+        const char* eol{
+            static_cast<const char*>(std::memchr(pos, '\n', end - pos))
+        };
+        if (!isBlankLine(stringV(pos, (eol ? eol : end) - pos))) { break; }
+        pos = eol ? eol + 1 : end;
+    }
+    return pos;
+}
+
+/*
+ * Find the last line that is not blank.
+ */
+stringV ColData::findMappedLastLine(const char* bgn, const char* end) {
+    while (end > bgn && isspace(static_cast<unsigned char>(end[-1]))) {
+        --end;
+    }
+    const char* lineBgn{end};
+    while (lineBgn > bgn && lineBgn[-1] != '\n') { --lineBgn; }
+    return {lineBgn, static_cast<size_t>(end - lineBgn)};
+}
+
+/*
+ * Find the beginning of the first row whose timestep is not less than the
+ * given timestep, or the end if there is none, by a binary search over the
+ * bytes that assumes that the timesteps increase down the rows; the last few
+ * rows are searched in order. Each timestep read must lie between those read
+ * above and below it, so that rows out of order are caught where they are
+ * read. The bytes read are added to the given count. Return nullptr if a
+ * timestep cannot be read or is out of order.
+ */
+const char* ColData::findMappedTimestep(const char* bgn, const char* end,
+        const string& dlm, const Delimitation dataDlmType,
+        const int timestepColNo, const size_t timestep, size_t& bytesScanned) {
+    auto readTimestep = [&](const char*& pos, const char* row, size_t& value) {
+        const char* eol{
+            static_cast<const char*>(std::memchr(row, '\n', end - row))
+        };
+        const char* next{eol ? eol + 1 : end};
+        bytesScanned += next - pos;
+        pos = next;
+        return readMappedTimestep(stringV(row, (eol ? eol : end) - row), dlm,
+            dataDlmType, timestepColNo, value);
+    };
+    const char* lo{bgn};
+    const char* hi{end};
+    size_t value, loValue{0}, hiValue{std::numeric_limits<size_t>::max()};
+    bool loFound{false};
+    auto isOrdered = [&]() {
+        return (!loFound || value > loValue) && value < hiValue;
+    };
+    while (static_cast<size_t>(hi - lo) > minChunkBytes) {
+        const char* pos{lo + (hi - lo)/2};
+        const char* row{findMappedRow(bgn, end, pos)};
+        if (row >= hi) { break; }
+        if (!readTimestep(pos, row, value) || !isOrdered()) { return nullptr; }
+        if (value >= timestep) {
+            hi = row;
+            hiValue = value;
+        }
+        else {
+            lo = row + 1;
+            loValue = value;
+            loFound = true;
+        }
+    }
+    const char* pos{lo};
+    for (const char* row{findMappedRow(bgn, end, pos)}; row < end;
+            row = findMappedRow(bgn, end, pos)) {
+        if (!readTimestep(pos, row, value) || !isOrdered()) { return nullptr; }
+        if (value >= timestep) { return row; }
+        loValue = value;
+        loFound = true;
+    }
+    return end;
+}
+
+/*
+ * Find the window of rows to be loaded from the range of rows or timesteps of
+ * the load options. The rows before the window are counted without reading
+ * their fields, and the rows of the timesteps are found by a binary search.
+ * With an index of the file, the rows are counted and the timesteps are
+ * searched only from the indexed rows nearest to the window. The row offset of
+ * the window, whether more rows follow it and the bytes counted and searched
+ * are set in the load statistics. If the window cannot be found, the whole
+ * data is returned, so that the ranges are checked as usual.
+ */
+tuple<const char*, const char*> ColData::findMappedWindow(const char* bgn,
+        const char* end, const string& dlm, const Delimitation dataDlmType,
+        const int timestepColNo, const LoadOptions& loadOptions,
+        LoadStats& loadStats) {
+    const char* windowBgn{bgn};
+    const char* windowEnd{end};
+    const char* countEnd{bgn};
+    RowCounter rowCounter;
+    const RowIndex* rowIndexP{loadOptions.rowIndexP};
+    const char* fileBgn{rowIndexP ? bgn - rowIndexP->getDataOffset() : bgn};
+    size_t bytesCounted{0}, bytesSearched{0};
+
+    if (loadOptions.rowBgnDefined || loadOptions.rowEndDefined) {
+        size_t rowBgn{loadOptions.rowBgnDefined ? loadOptions.rowBgn : 0};
+        size_t rowEnd{loadOptions.rowEnd};
+        if (loadOptions.rowBgnDefined && loadOptions.rowEndDefined
+                && rowBgn > rowEnd) {
+            std::swap(rowBgn, rowEnd);
+        }
+        if (rowIndexP) {
+            // Count the rows only from the indexed rows before the window
+            size_t indexedRow, offset;
+            tie(indexedRow, offset) = rowIndexP->findRowOffset(rowBgn);
+            windowBgn = RowCounter().skip(fileBgn + offset, end,
+                rowBgn - indexedRow);
+            bytesCounted = windowBgn - (fileBgn + offset);
+            if (loadOptions.rowEndDefined) {
+                tie(indexedRow, offset) = rowIndexP->findRowOffset(rowEnd + 1);
+                const char* seekBgn{fileBgn + offset};
+                if (indexedRow <= rowBgn) {
+                    indexedRow = rowBgn;
+                    seekBgn = windowBgn;
+                }
+                windowEnd = RowCounter().skip(seekBgn, end,
+                    rowEnd + 1 - indexedRow);
+                bytesCounted += windowEnd - seekBgn;
+            }
+            countEnd = bgn + bytesCounted;
+        }
+        else {
+            windowBgn = countEnd = rowCounter.skip(bgn, end, rowBgn);
+            if (loadOptions.rowEndDefined) {
+                windowEnd = countEnd =
+                    rowCounter.skip(windowBgn, end, rowEnd + 1);
+            }
+        }
+        loadStats.rowOffset = rowBgn;
+    }
+    else if (timestepColNo >= 0 && rowIndexP
+            && get<0>(rowIndexP->getTimestepRange())) {
+        // Search only the span between the indexed rows around each timestep
+        size_t timestepBgn{loadOptions.timestepBgn};
+        size_t timestepEnd{loadOptions.timestepEnd};
+        if (loadOptions.timestepBgnDefined && loadOptions.timestepEndDefined
+                && timestepBgn > timestepEnd) {
+            std::swap(timestepBgn, timestepEnd);
+        }
+        size_t indexedRow{0}, offset, offsetEnd;
+        if (loadOptions.timestepBgnDefined) {
+            tie(indexedRow, offset, offsetEnd) =
+                rowIndexP->findTimestepOffsets(timestepBgn);
+            windowBgn = findMappedTimestep(fileBgn + offset,
+                fileBgn + offsetEnd, dlm, dataDlmType, timestepColNo,
+                timestepBgn, bytesSearched);
+            if (!windowBgn) { return {bgn, end}; }
+            rowCounter.count(fileBgn + offset, windowBgn);
+            bytesCounted = windowBgn - (fileBgn + offset);
+        }
+        if (loadOptions.timestepEndDefined) {
+            tie(std::ignore, offset, offsetEnd) =
+                rowIndexP->findTimestepOffsets(timestepEnd + 1);
+            windowEnd = findMappedTimestep(fileBgn + offset,
+                fileBgn + offsetEnd, dlm, dataDlmType, timestepColNo,
+                timestepEnd + 1, bytesSearched);
+            if (!windowEnd) { return {bgn, end}; }
+        }
+        countEnd = bgn + bytesCounted;
+        loadStats.rowOffset = indexedRow + rowCounter.getRowTotal();
+    }
+    else if (timestepColNo >= 0) {
+        size_t timestepBgn{loadOptions.timestepBgn};
+        size_t timestepEnd{loadOptions.timestepEnd};
+        if (loadOptions.timestepBgnDefined && loadOptions.timestepEndDefined
+                && timestepBgn > timestepEnd) {
+            std::swap(timestepBgn, timestepEnd);
+        }
+        if (loadOptions.timestepBgnDefined) {
+            windowBgn = findMappedTimestep(bgn, end, dlm, dataDlmType,
+                timestepColNo, timestepBgn, bytesSearched);
+            if (!windowBgn) { return {bgn, end}; }
+        }
+        if (loadOptions.timestepEndDefined) {
+            windowEnd = findMappedTimestep(windowBgn, end, dlm, dataDlmType,
+                timestepColNo, timestepEnd + 1, bytesSearched);
+            if (!windowEnd) { return {bgn, end}; }
+        }
+        rowCounter.count(bgn, windowBgn);
+        countEnd = windowBgn;
+        loadStats.rowOffset = rowCounter.getRowTotal();
+    }
+    else {
+        return {bgn, end};
+    }
+    if (windowBgn >= windowEnd
+            || isBlankLine(stringV(windowBgn, windowEnd - windowBgn))) {
+        loadStats.rowOffset = 0;
+        return {bgn, end};
+    }
+    loadStats.windowed = true;
+    loadStats.partial =
+        !isBlankLine(stringV(windowEnd, end - windowEnd));
+    loadStats.bytesScanned = (countEnd - bgn) + bytesSearched;
+    return {windowBgn, windowEnd};
+}
+
+/*
+ * Select the leftmost remaining integer column candidate as the timestep column
+ * and move it and the selected data columns into their column vectors; the data
+ * columns that are not selected are created empty.
+ */
+void ColData::storeMappedColumns(const vector<string>& colNames,
+        vector<ColumnBuffer>& colData, const vector<bool>& intColCandidates,
+        const vector<bool>& selectedCols) {
+    Table& table{Table::getCurrent()};
+    const int dataColTotal{static_cast<int>(colData.size())};
+    for (int c=0; c<dataColTotal; ++c) {
+        if (intColCandidates[c]) {
+            table.getIntColNoSet().insert(c);
+            break;
+        }
+    }
+    for (int c=0; c<dataColTotal; ++c) {
+        if (!table.getIntColNoSet().count(c)) {
+            table.getDoubleColNoSet().insert(c);
+        }
+    }
+    for (int colNo : table.getIntColNoSet()) {
+        const ColSpan<int> intData{
+            table.getArena().store<int>(colData[colNo].getValues())
+        };
+        colData[colNo].release();
+        new IntV(table, colNo, colNames[colNo], intData);
+    }
+    for (int colNo : table.getDoubleColNoSet()) {
+        if (!selectedCols[colNo]) { colData[colNo].release(); }
+        new DoubleV(table, colNo, colNames[colNo],
+            std::move(colData[colNo]));
+    }
+}
@@ -0,0 +1,89 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        fileMap.h
+ * @brief       Memory-map the input file and load the column data from it in a
+ *              single forward scan.
+ */
+
+#ifndef FILEMAP_H
+#define FILEMAP_H
+
+#include "namespaces.h"
+#include "errorMsgs.h"
+
+//----------------------------------------------------------------------------//
+//************************ ColData::MappedFile Class *************************//
+//----------------------------------------------------------------------------//
+/*
+ * Read-only memory mapping of a file, which is unmapped on destruction.
+ */
+class ColData::MappedFile {
+  private:
+    int         m_fd{-1};
+    const char* m_data{nullptr};
+    size_t      m_size{0};
+
+    MappedFile() = delete;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+  public:
+    explicit MappedFile(const string& fileName);
+    ~MappedFile();
+
+    const char* getData() const;
+    size_t getSize() const;
+    stringV getView() const;
+};
+
+//----------------------------------------------------------------------------//
+//********************** ColData::FixedWidthRows Class ***********************//
+//----------------------------------------------------------------------------//
+/*
+ * Layout of spaced data whose rows all have the same length and whose fields
+ * end at the same bytes of every row, as written by Fortran formats. The
+ * layout is taken from the first row and is found if the first rows, the last
+ * row and the size of the data all agree with it. Any row can then be reached
+ * by offset arithmetic and its fields sliced at their known offsets.
+ */
+class ColData::FixedWidthRows {
+  private:
+    inline static constexpr size_t s_sampleRowTotal{64};
+    const char*     m_bgn;
+    const char*     m_end;
+    size_t          m_rowLength{0};     // with the newline; 0 if not found
+    size_t          m_rowTotal{0};
+    vector<size_t>  m_fieldBgns{};      // offsets in the row of the first row
+    vector<size_t>  m_fieldEnds{};
+
+    FixedWidthRows() = delete;
+    FixedWidthRows(const FixedWidthRows&) = delete;
+    FixedWidthRows& operator=(const FixedWidthRows&) = delete;
+
+    bool fitsRow(const char* row, const char* end) const;
+    bool sliceField(const char* row, const size_t f, stringV& field) const;
+    bool readTimestep(const size_t row, const int timestepColNo,
+        size_t& timestep) const;
+    bool findTimestepRow(const size_t timestep, const int timestepColNo,
+        size_t lo, size_t& row, size_t& bytesScanned) const;
+
+  public:
+    explicit FixedWidthRows(const char* bgn, const char* end,
+        const string& dlm, const Delimitation dataDlmType);
+
+    bool isFound() const;
+    size_t getRowLength() const;
+    size_t getRowTotal() const;
+    const char* findRow(const size_t row) const;
+    bool readFields(const char* row, const char* end,
+        vector<stringV>& fields) const;
+    bool readField(const char* row, const char* end, const int colNo,
+        stringV& field) const;
+    tuple<const char*, const char*> findWindow(const int timestepColNo,
+        const LoadOptions& loadOptions, LoadStats& loadStats) const;
+};
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        index.cpp
+ * @brief       Keep the layout of an input file in a sidecar index file, so
+ *              that it need not be found again by later runs on that file.
+ */
+
+#include "namespaces.h"
+#include "colData.h"
+#include "fileMap.h"
+#include "scanner.h"
+#include "index.h"
+#include "errorMsgs.h"
+
+using namespace ColData;
+
+//----------------------------------------------------------------------------//
+//************************* ColData::RowIndex Class **************************//
+//----------------------------------------------------------------------------//
+string RowIndex::getIndexFileName(const string& fileName) {
+    return fileName + ".cdi";
+}
+
+/*
+ * Read the index of the given input file. Return false if there is no index,
+ * or if it is not a complete index of the file as it is now with the given
+ * delimiter.
+ */
+bool RowIndex::read(const string& fileName, const string& dlm) {
+    std::error_code error;
+    const size_t fileSize{std::filesystem::file_size(fileName, error)};
+    if (error) { return false; }
+    ifstream iFile{getIndexFileName(fileName), std::ios::binary};
+    if (!iFile) { return false; }
+
+    auto readValue = [&iFile](auto& value) {
+        iFile.read(reinterpret_cast<char*>(&value), sizeof(value));
+    };
+    auto readValues = [&iFile, &readValue](auto& values) {
+        uint64_t total{0};
+        readValue(total);
+        if (!iFile || total > numeric_limits<uint32_t>::max()) {
+            iFile.setstate(ios_base::failbit);
+            return;
+        }
+        values.resize(total);
+        iFile.read(reinterpret_cast<char*>(values.data()),
+            total*sizeof(values[0]));
+    };
+    char magic[sizeof(s_magic)];
+    iFile.read(magic, sizeof(magic));
+    if (!iFile || !std::equal(magic, magic + sizeof(magic), s_magic)) {
+        return false;
+    }
+    uint64_t rowInterval;
+    int32_t dataDlmType, dataColTotal, timestepColNo;
+    uint8_t timestepConsistent;
+    readValue(m_fileSize), readValue(m_fileTime);
+    readValues(m_dlm);
+    readValue(dataDlmType), readValue(dataColTotal), readValue(timestepColNo);
+    readValue(timestepConsistent);
+    readValue(m_headerOffset), readValue(m_dataOffset);
+    readValue(m_dataRowTotal), readValue(rowInterval);
+    readValues(m_rowOffsets), readValues(m_timesteps);
+    readValue(m_timestepLast);
+    if (!iFile || m_fileSize != fileSize
+            || m_fileTime != findFileTime(fileName) || m_dlm != dlm
+            || rowInterval != indexRowInterval) {
+        return false;
+    }
+    m_dataDlmType = static_cast<Delimitation>(dataDlmType);
+    m_dataColTotal = dataColTotal;
+    m_timestepColNo = timestepColNo;
+    m_timestepConsistent = timestepConsistent;
+    return true;
+}
+
+/*
+ * Build the index of the given input file from the results of its full load.
+ * The offsets of the rows are found by counting the rows of the mapped file,
+ * and the timesteps of the indexed rows are taken from the loaded timestep
+ * column; they are indexed only if they increase down the rows. Return false
+ * if the rows counted are not the rows loaded.
+ */
+bool RowIndex::build(const string& fileName, const string& dlm,
+        const Delimitation dataDlmType, const int dataColTotal,
+        const size_t dataRowTotal, const IntV* dataTimestepIVP) {
+    const MappedFile map{fileName};
+    stringV headerLine, dataLine;
+    size_t dataOffset;
+    tie(headerLine, dataLine, dataOffset) = findMappedLines(map.getView(), dlm);
+
+    m_fileSize = map.getSize();
+    m_fileTime = findFileTime(fileName);
+    m_dlm = dlm;
+    m_dataDlmType = dataDlmType;
+    m_dataColTotal = dataColTotal;
+    m_headerOffset = headerLine.data() - map.getData();
+    m_dataOffset = dataOffset;
+    m_dataRowTotal = dataRowTotal;
+    m_rowOffsets.clear(), m_timesteps.clear();
+
+    const char* bgn{map.getData() + dataOffset};
+    const char* end{map.getData() + map.getSize()};
+    RowCounter rowCounter;
+    for (const char* row{bgn}; ; ) {
+        row = findMappedRow(bgn, end, row);
+        if (row >= end) { break; }
+        m_rowOffsets.push_back(row - map.getData());
+        row = rowCounter.skip(row, end,
+            m_rowOffsets.size()*indexRowInterval);
+    }
+    if (rowCounter.getRowTotal() != dataRowTotal) { return false; }
+
+    m_timestepColNo = dataTimestepIVP ? dataTimestepIVP->getColNo() : -1;
+    m_timestepConsistent = dataTimestepIVP
+        && get<0>(dataTimestepIVP->getTimestepRange());
+    if (m_timestepConsistent) {
+        const ColSpan<int>& timesteps{dataTimestepIVP->getData()};
+        for (size_t r=0; r<dataRowTotal; r+=indexRowInterval) {
+            m_timesteps.push_back(timesteps[r]);
+        }
+        m_timestepLast = timesteps.back();
+    }
+    return true;
+}
+
+/*
+ * Write the index next to the given input file. Return false if it cannot be
+ * written, in which case no index is left behind.
+ */
+bool RowIndex::write(const string& fileName) const {
+    const string indexFileName{getIndexFileName(fileName)};
+    ofstream oFile{indexFileName, std::ios::binary | std::ios::trunc};
+    if (!oFile) { return false; }
+
+    auto writeValue = [&oFile](const auto& value) {
+        oFile.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    auto writeValues = [&oFile, &writeValue](const auto& values) {
+        writeValue(static_cast<uint64_t>(values.size()));
+        oFile.write(reinterpret_cast<const char*>(values.data()),
+            values.size()*sizeof(values[0]));
+    };
+    oFile.write(s_magic, sizeof(s_magic));
+    writeValue(m_fileSize), writeValue(m_fileTime);
+    writeValues(m_dlm);
+    writeValue(static_cast<int32_t>(m_dataDlmType));
+    writeValue(static_cast<int32_t>(m_dataColTotal));
+    writeValue(static_cast<int32_t>(m_timestepColNo));
+    writeValue(static_cast<uint8_t>(m_timestepConsistent));
+    writeValue(m_headerOffset), writeValue(m_dataOffset);
+    writeValue(m_dataRowTotal), writeValue(uint64_t{indexRowInterval});
+    writeValues(m_rowOffsets), writeValues(m_timesteps);
+    writeValue(m_timestepLast);
+    oFile.close();
+    if (!oFile) {
+        std::error_code error;
+        std::filesystem::remove(indexFileName, error);
+        return false;
+    }
+    return true;
+}
+
+Delimitation RowIndex::getDataDlmType() const   { return m_dataDlmType; }
+int RowIndex::getDataColTotal() const           { return m_dataColTotal; }
+int RowIndex::getTimestepColNo() const          { return m_timestepColNo; }
+size_t RowIndex::getHeaderOffset() const        { return m_headerOffset; }
+size_t RowIndex::getDataOffset() const          { return m_dataOffset; }
+size_t RowIndex::getDataRowTotal() const        { return m_dataRowTotal; }
+
+tuple<bool, size_t, size_t> RowIndex::getTimestepRange() const {
+    if (!m_timestepConsistent || m_timesteps.empty()) { return {false, 0, 0}; }
+    return {true, m_timesteps.front(), m_timestepLast};
+}
+
+/*
+ * Find the last indexed row that is not after the given row, and return its
+ * row number and file offset.
+ */
+tuple<size_t, size_t> RowIndex::findRowOffset(const size_t row) const {
+    if (m_rowOffsets.empty()) { return {0, m_dataOffset}; }
+    const size_t i{std::min(row/indexRowInterval, m_rowOffsets.size() - 1)};
+    return {i*indexRowInterval, m_rowOffsets[i]};
+}
+
+/*
+ * Find the span of the file in which the first row whose timestep is not less
+ * than the given timestep begins: from the last indexed row whose timestep is
+ * less than it, or the first indexed row, to the next indexed row, or the end
+ * of the file. Return the row number of the span and its file offsets.
+ */
+tuple<size_t, size_t, size_t> RowIndex::findTimestepOffsets(
+        const size_t timestep) const {
+    const size_t i{static_cast<size_t>(
+        std::lower_bound(m_timesteps.cbegin(), m_timesteps.cend(), timestep)
+            - m_timesteps.cbegin())};
+    const size_t bgn{i > 0 ? i - 1 : 0};
+    const size_t end{bgn + 1};
+    return {bgn*indexRowInterval, m_rowOffsets[bgn],
+            end < m_rowOffsets.size() ? m_rowOffsets[end] : m_fileSize};
+}
+
+//----------------------------------------------------------------------------//
+//*************************** Indexed data loading ***************************//
+//----------------------------------------------------------------------------//
+/*
+ * Load the data with the help of the index of the input file, which gives the
+ * positions of the header and the data, the classification of the columns,
+ * the number of rows, and the rows and timesteps to seek to for a window. If
+ * the file has no valid index, it is loaded whole and its index is built and
+ * written for the later runs; an index that cannot be written is skipped.
+ * Return the same variables as ColData::loadData().
+ */
+const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+        ColData::loadIndexedData(const string& fileName, const string& dlm,
+            const LoadOptions& loadOptions) {
+    RowIndex rowIndex;
+    LoadOptions indexedOptions{loadOptions};
+    indexedOptions.indexed = false;
+    if (rowIndex.read(fileName, dlm)) {
+        indexedOptions.rowIndexP = &rowIndex;
+        return loadData(fileName, dlm, indexedOptions);
+    }
+
+    indexedOptions.windowed = false;
+    const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+        loadedData{loadData(fileName, dlm, indexedOptions)};
+    if (rowIndex.build(fileName, dlm, get<0>(loadedData), get<1>(loadedData),
+            get<2>(loadedData), get<3>(loadedData))) {
+        rowIndex.write(fileName);
+    }
+    return loadedData;
+}
@@ -0,0 +1,70 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        index.h
+ * @brief       Keep the layout of an input file in a sidecar index file, so
+ *              that it need not be found again by later runs on that file.
+ */
+
+#ifndef INDEX_H
+#define INDEX_H
+
+#include "namespaces.h"
+#include "errorMsgs.h"
+
+//----------------------------------------------------------------------------//
+//************************* ColData::RowIndex Class **************************//
+//----------------------------------------------------------------------------//
+/*
+ * Sidecar index of an input file, which is kept next to it with the extension
+ * ".cdi". It holds the offsets of the header and the data, the delimitation
+ * type, the number of columns and rows, the timestep column, and the byte
+ * offset and the timestep of every indexRowInterval-th row. It is valid only
+ * for the same delimiter and for a file of the same size and time of last
+ * modification.
+ */
+class ColData::RowIndex {
+  private:
+    inline static constexpr char    s_magic[4]{'C', 'D', 'I', '1'};
+    size_t                          m_fileSize{0};
+    int64_t                         m_fileTime{0};
+    string                          m_dlm{};
+    Delimitation                    m_dataDlmType{Delimitation::undefined};
+    int                             m_dataColTotal{0};
+    int                             m_timestepColNo{-1};
+    bool                            m_timestepConsistent{false};
+    size_t                          m_headerOffset{0};
+    size_t                          m_dataOffset{0};
+    size_t                          m_dataRowTotal{0};
+    vector<size_t>                  m_rowOffsets{};
+    vector<size_t>                  m_timesteps{};
+    size_t                          m_timestepLast{0};
+
+    RowIndex(const RowIndex&) = delete;
+    RowIndex& operator=(const RowIndex&) = delete;
+
+  public:
+    explicit RowIndex() = default;
+
+    static string getIndexFileName(const string& fileName);
+    bool read(const string& fileName, const string& dlm);
+    bool build(const string& fileName, const string& dlm,
+        const Delimitation dataDlmType, const int dataColTotal,
+        const size_t dataRowTotal, const IntV* dataTimestepIVP);
+    bool write(const string& fileName) const;
+
+    Delimitation getDataDlmType() const;
+    int getDataColTotal() const;
+    int getTimestepColNo() const;
+    size_t getHeaderOffset() const;
+    size_t getDataOffset() const;
+    size_t getDataRowTotal() const;
+    tuple<bool, size_t, size_t> getTimestepRange() const;
+    tuple<size_t, size_t> findRowOffset(const size_t row) const;
+    tuple<size_t, size_t, size_t> findTimestepOffsets(
+        const size_t timestep) const;
+};
+
+#endif
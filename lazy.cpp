@@ -0,0 +1,135 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        lazy.cpp
+ * @brief       Keep the rows of a memory-mapped input file, so that each data
+ *              column is decoded from them only when it is first used.
+ */
+
+#include <cstring>
+
+#include "namespaces.h"
+#include "colData.h"
+#include "fileMap.h"
+#include "lazy.h"
+#include "tokenizer.h"
+#include "errorMsgs.h"
+
+using namespace ColData;
+
+//----------------------------------------------------------------------------//
+//*********************** ColData::ColumnSource Class ************************//
+//----------------------------------------------------------------------------//
+/*
+ * Find the rows between the given pointers of the shared mapping, which must
+ * be as many as the rows loaded, and hand the source to the given table, which
+ * keeps it until its columns are deleted.
+ */
+ColumnSource::ColumnSource(Table& table,
+        std::shared_ptr<const MappedFile> mapP, const char* dataBgn,
+        const char* dataEnd, const string& dlm,
+        const Delimitation dataDlmType, const size_t dataRowTotal) :
+  m_table{table}, m_mapP{std::move(mapP)}, m_bgn{dataBgn}, m_end{dataEnd},
+  m_dlm{dlm}, m_dataDlmType{dataDlmType} {
+    m_fixedRowsP.reset(new FixedWidthRows(m_bgn, m_end, dlm, dataDlmType));
+    if (m_fixedRowsP->isFound()
+            && m_fixedRowsP->getRowTotal() == dataRowTotal) {
+        m_rowTotal = dataRowTotal;
+    }
+    else {
+        m_fixedRowsP.reset();
+        findRowOffsets();
+    }
+    if (m_rowTotal != dataRowTotal) {
+        throw runtime_error(errorDlmFormatIncorrect);
+    }
+    m_table.addSource(this);
+}
+
+/*
+ * Find the beginning of every row that is not blank, as its offset from the
+ * beginning of the rows.
+ */
+void ColumnSource::findRowOffsets() {
+    for (const char* pos{m_bgn}; pos < m_end; ) {
+        const char* eol{
+            static_cast<const char*>(std::memchr(pos, '\n', m_end - pos))
+        };
+        const char* next{eol ? eol + 1 : m_end};
+        if (!isBlankLine(stringV(pos, next - pos))) {
+            if (m_rowTotal%indexRowInterval == 0) {
+                m_blockOffsets.push_back(pos - m_bgn);
+            }
+            m_rowOffsets.push_back(
+                static_cast<uint32_t>(pos - m_bgn - m_blockOffsets.back()));
+            ++m_rowTotal;
+        }
+        pos = next;
+    }
+}
+
+/*
+ * Find the beginning of the given row, or the end if there is no such row.
+ */
+const char* ColumnSource::findRow(const size_t row) const {
+    if (row >= m_rowTotal) { return m_end; }
+    if (m_fixedRowsP) { return m_fixedRowsP->findRow(row); }
+    return m_bgn + m_blockOffsets[row/indexRowInterval] + m_rowOffsets[row];
+}
+
+/*
+ * Attach the source to the data columns of its table that are to be decoded
+ * from it.
+ */
+void ColumnSource::createColumns(const vector<bool>& lazyCols) {
+    for (DoubleV* dVP : m_table.getDoubleVSetP()) {
+        if (lazyCols[dVP->getColNo()]) { dVP->setSource(this); }
+    }
+}
+
+/*
+ * Decode the given column from every row into the given buffer, which is
+ * placed in the arena of the table first, slicing only its field from a
+ * fixed-width row. The delimiters before the field of any
+ * other delimited row are skipped without the fields being trimmed, and a
+ * spaced row is tokenized up to the field.
+ */
+void ColumnSource::decodeColumn(const int colNo, ColumnBuffer& values) const {
+    m_table.getArena().place(values, m_rowTotal);
+    FixedFormat format;
+    stringV field;
+    for (size_t r=0; r<m_rowTotal; ++r) {
+        const char* row{findRow(r)};
+        if (!m_fixedRowsP || !m_fixedRowsP->readField(row, m_end, colNo,
+                field)) {
+            stringV line{row, static_cast<size_t>(findRow(r+1) - row)};
+            int fieldsBefore{colNo};
+            if (m_dataDlmType != Delimitation::spaced) {
+                size_t pos{0};
+                for (; fieldsBefore>0 && pos!=stringV::npos; --fieldsBefore) {
+                    pos = line.find(m_dlm, pos);
+                    if (pos != stringV::npos) { pos += m_dlm.length(); }
+                }
+                if (pos == stringV::npos) {
+                    throw runtime_error(errorDlmFormatIncorrect);
+                }
+                line.remove_prefix(pos);
+            }
+            FieldTokenizer tokenizer{line, m_dlm, m_dataDlmType};
+            for (int c=0; c<=fieldsBefore; ++c) {
+                if (!tokenizer.next(field)) {
+                    throw runtime_error(errorDlmFormatIncorrect);
+                }
+            }
+        }
+        if (r == 0) { format = FixedFormat{field}; }
+        double value;
+        if (!format.toNumber(field, value)
+                && !FieldTokenizer::toNumber(field, value)) {
+            throw runtime_error(errorDataFormatIncorrect);
+        }
+        values.addValue(value);
+    }
+}
@@ -0,0 +1,63 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        lazy.h
+ * @brief       Keep the rows of a memory-mapped input file, so that each data
+ *              column is decoded from them only when it is first used.
+ */
+
+#ifndef LAZY_H
+#define LAZY_H
+
+#include <memory>
+
+#include "namespaces.h"
+#include "fileMap.h"
+#include "errorMsgs.h"
+
+//----------------------------------------------------------------------------//
+//*********************** ColData::ColumnSource Class ************************//
+//----------------------------------------------------------------------------//
+/*
+ * Rows of the data section, or of a window of it, of a mapped input file, from
+ * which the data columns are decoded one at a time. The beginning of every
+ * row is kept compactly, as the offset of every indexRowInterval-th row and
+ * the offset of each row from that one; rows of a fixed width are found from
+ * their width instead, and only the field of the column is sliced from each.
+ * The source shares the mapping that the rows were loaded from, so that the
+ * file is neither mapped nor scanned twice, and is owned by the table that it
+ * is created for, whose columns are decoded from it.
+ */
+class ColData::ColumnSource {
+  private:
+    Table&                                  m_table;
+    const std::shared_ptr<const MappedFile> m_mapP;
+    const char*                             m_bgn;
+    const char*                             m_end;
+    const string                            m_dlm;
+    const Delimitation                      m_dataDlmType;
+    std::unique_ptr<const FixedWidthRows>   m_fixedRowsP{};
+    size_t                                  m_rowTotal{0};
+    vector<size_t>                          m_blockOffsets{};
+    vector<uint32_t>                        m_rowOffsets{};
+
+    ColumnSource() = delete;
+    ColumnSource(const ColumnSource&) = delete;
+    ColumnSource& operator=(const ColumnSource&) = delete;
+
+    void findRowOffsets();
+    const char* findRow(const size_t row) const;
+
+  public:
+    explicit ColumnSource(Table& table,
+        std::shared_ptr<const MappedFile> mapP, const char* dataBgn,
+        const char* dataEnd, const string& dlm,
+        const Delimitation dataDlmType, const size_t dataRowTotal);
+
+    void createColumns(const vector<bool>& lazyCols);
+    void decodeColumn(const int colNo, ColumnBuffer& values) const;
+};
+
+#endif
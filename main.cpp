@@ -23,6 +23,7 @@ int main(int argc, char* argv[]) {
         CmdArgs::Args input(argc, argv);
         input.process();
         Output::output(&input);
+        while (input.follow()) { Output::output(&input); }
     }
     catch (const invalid_argument& exception) {
         std::cerr
@@ -47,5 +48,5 @@ int main(int argc, char* argv[]) {
 
 /*
  * Compilation:
-g++ -std=c++17 -Wpedantic -Wall -Wextra -O3 output.cpp cmdArgs.cpp colData.cpp main.cpp libfftw3.a -o coldatautil
+g++ -std=c++17 -Wpedantic -Wall -Wextra -O3 -pthread output.cpp cmdArgs.cpp colData.cpp fileMap.cpp scanner.cpp stream.cpp index.cpp lazy.cpp cache.cpp pipe.cpp merge.cpp main.cpp libfftw3.a -lz -o coldatautil
  */
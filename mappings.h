@@ -49,6 +49,17 @@ inline const unordered_map<string, Option> CmdArgs::mapStrToOption {
     {"--output",        Option::fileOut},
     {"--print-data",    Option::printData},
     {"--file-data",     Option::fileData},
+    {"--mmap",          Option::mmap},
+    {"--threads",       Option::threads},
+    {"--stream",        Option::stream},
+    {"--follow",        Option::follow},
+    {"--index",         Option::index},
+    {"--cache",         Option::cache},
+    {"--precision",     Option::precision},
+    {"--lazy",          Option::lazy},
+    {"--read-ahead",    Option::readAhead},
+    {"--huge-pages",    Option::hugePages},
+    {"--prefix-sums",   Option::prefixSums},
     {"--help",          Option::help},
     {"--version",       Option::version},
 };
@@ -81,8 +92,9 @@ inline const unordered_map<string, CalcId> CmdArgs::mapStrToCalc {
     // {"fourier",             CalcId::findFourier},
 };
 
+namespace Output {
 template<typename T> inline const unordered_map<CmdArgs::CalcId, calcType>
-        Output::mapCalcIdToCalc {
+        mapCalcIdToCalc {
     {CmdArgs::CalcId::findMin,            CalcFnc::findMin},
     {CmdArgs::CalcId::findMax,            CalcFnc::findMax},
     {CmdArgs::CalcId::findAbsMin,         CalcFnc::findAbsMin},
@@ -93,9 +105,11 @@ template<typename T> inline const unordered_map<CmdArgs::CalcId, calcType>
     {CmdArgs::CalcId::findCubicMean,      CalcFnc::findCubicMean},
     // {CmdArgs::CalcId::findFourier,        CalcFnc::findFourier},
 };
+}
 
+namespace CalcFnc {
 template<typename T>
-inline const unordered_map<calcType, string> CalcFnc::mapCalcToStr {
+inline const unordered_map<calcType, string> mapCalcToStr {
     {CalcFnc::findMin,           "minimum"},
     {CalcFnc::findMax,           "maximum"},
     {CalcFnc::findAbsMin,        "absolute minimum"},
@@ -106,6 +120,7 @@ inline const unordered_map<calcType, string> CalcFnc::mapCalcToStr {
     {CalcFnc::findCubicMean,     "cubic mean"},
     // {CalcFnc::findFourier,       "fourier"}
 };
+}
 
 inline const unordered_map<string, CycleInit> CmdArgs::mapStrToCycleInit {
     {"f",       CycleInit::first},
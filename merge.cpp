@@ -0,0 +1,206 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        merge.cpp
+ * @brief       Load several input files, such as the files of the restarts of
+ *              a run, in parallel and merge them into one set of columns by
+ *              their timesteps.
+ */
+
+#include <atomic>
+#include <memory>
+
+#include "namespaces.h"
+#include "colData.h"
+#include "fileMap.h"
+#include "merge.h"
+#include "errorMsgs.h"
+
+using namespace ColData;
+
+//----------------------------------------------------------------------------//
+//*********************** ColData::FileSegment Class *************************//
+//----------------------------------------------------------------------------//
+FileSegment::FileSegment(const string& fileName) : m_fileName{fileName} {}
+
+/*
+ * Map the file and parse its header and all of its rows on the calling thread.
+ */
+void FileSegment::parse(const string& dlm, const LoadOptions& loadOptions) {
+    if (findCompression(m_fileName) != Compression::none) {
+        throw runtime_error(errorMergeCompressed);
+    }
+    const MappedFile map{m_fileName};
+    m_fileSize = map.getSize();
+
+    stringV headerLine, dataLine;
+    size_t dataOffset;
+    tie(headerLine, dataLine, dataOffset) = findMappedLines(map.getView(), dlm);
+
+    string headerStr;
+    Delimitation headerDlmType;
+    tie(headerStr, headerDlmType) = parseHeaderLine(string{headerLine}, dlm);
+
+    int dataColTotal;
+    tie(dataColTotal, m_colNames) =
+        identifyColumnHeaders(headerStr, dlm, headerDlmType);
+    m_intColCandidates.assign(dataColTotal, false);
+    for (int c : findTimestepColCandidates(dataColTotal, m_colNames)) {
+        m_intColCandidates[c] = true;
+    }
+    m_selectedCols = selectColumns(m_colNames, loadOptions);
+    vector<bool> parsedCols(dataColTotal);
+    for (int c=0; c<dataColTotal; ++c) {
+        parsedCols[c] = m_selectedCols[c] || m_intColCandidates[c];
+    }
+    m_dataDlmType = parseColumnData(dataLine, dlm);
+
+    m_colData = createColumnBuffers(m_intColCandidates);
+    m_dataRowTotal = parseMappedChunks(map.getData() + dataOffset,
+        map.getData() + map.getSize(), dlm, m_dataDlmType, dataColTotal,
+        nullptr, 1, nullptr, parsedCols, m_colData, m_intColCandidates);
+    if (m_dataRowTotal == 0) { throw runtime_error(errorDlmFormatIncorrect); }
+}
+
+size_t FileSegment::getFileSize() const             { return m_fileSize; }
+Delimitation FileSegment::getDataDlmType() const    { return m_dataDlmType; }
+const vector<string>& FileSegment::getColNames() const { return m_colNames; }
+const vector<bool>& FileSegment::getIntColCandidates() const {
+    return m_intColCandidates;
+}
+const vector<bool>& FileSegment::getSelectedCols() const {
+    return m_selectedCols;
+}
+vector<ColumnBuffer>& FileSegment::getColData()     { return m_colData; }
+size_t FileSegment::getDataRowTotal() const         { return m_dataRowTotal; }
+
+//----------------------------------------------------------------------------//
+//**************************** Merged data loading ***************************//
+//----------------------------------------------------------------------------//
+/*
+ * Load the given files, which must have the same columns, as one file. The
+ * files are parsed in parallel, one file per thread. The timestep column is
+ * the leftmost column that is an integer column candidate in every file, and
+ * the files are then ordered by their first timesteps, keeping the given order
+ * of the files that begin at the same timestep. Where a file begins at or
+ * before a timestep of an earlier file, as after a restart that rewound, the
+ * rows of the earlier file from that timestep on are dropped, so that the
+ * newest rows are kept and the merged timesteps keep increasing. Without a
+ * timestep column, the files are joined in the given order. Return the same
+ * variables as ColData::loadData().
+ */
+const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+        ColData::loadMergedData(const vector<string>& fileNames,
+            const string& dlm, const LoadOptions& loadOptions) {
+    // Parse the files in parallel -------------------------------------------//
+    DoubleV::setFloatStorage(loadOptions.floatStored);
+    ColumnArena::setHugePages(loadOptions.hugePages);
+    DoubleV::setPrefixSums(loadOptions.prefixSums);
+    const size_t fileTotal{fileNames.size()};
+    vector<std::unique_ptr<FileSegment>> segments;
+    for (const string& fileName : fileNames) {
+        segments.emplace_back(new FileSegment(fileName));
+    }
+    cout << "File found. Program initiated." << flush;
+    cout << "\rIn progress: Parsing column data..." << flush;
+    const size_t workerTotal{std::min<size_t>(fileTotal,
+        std::max(std::thread::hardware_concurrency(), 1u))};
+    std::atomic<size_t> next{0};
+    vector<std::exception_ptr> errors(fileTotal);
+    vector<std::thread> workers;
+    for (size_t t=0; t<workerTotal; ++t) {
+        workers.emplace_back([&]() {
+            for (size_t f; (f = next++) < fileTotal; ) {
+                try { segments[f]->parse(dlm, loadOptions); }
+                catch (...) { errors[f] = std::current_exception(); }
+            }
+        });
+    }
+    for (std::thread& worker : workers) { worker.join(); }
+    for (const std::exception_ptr& error : errors) {
+        if (error) { std::rethrow_exception(error); }
+    }
+
+    // Match the columns of the files ----------------------------------------//
+    const vector<string>& colNames{segments[0]->getColNames()};
+    const int dataColTotal{static_cast<int>(colNames.size())};
+    vector<bool> intColCandidates{segments[0]->getIntColCandidates()};
+    for (const std::unique_ptr<FileSegment>& segment : segments) {
+        if (segment->getColNames() != colNames) {
+            throw runtime_error(errorMergeColumns);
+        }
+        for (int c=0; c<dataColTotal; ++c) {
+            if (!segment->getIntColCandidates()[c]) {
+                intColCandidates[c] = false;
+            }
+        }
+    }
+    const int timestepColNo{static_cast<int>(
+        std::find(intColCandidates.cbegin(), intColCandidates.cend(), true)
+            - intColCandidates.cbegin())};
+    const bool timestepFound{timestepColNo < dataColTotal};
+
+    // Order the files and find the rows kept from each ----------------------//
+    vector<size_t> order(fileTotal);
+    std::iota(order.begin(), order.end(), 0);
+    vector<size_t> rowsKept(fileTotal);
+    for (size_t f=0; f<fileTotal; ++f) {
+        rowsKept[f] = segments[f]->getDataRowTotal();
+    }
+    if (timestepFound) {
+        auto firstTimestep = [&segments, timestepColNo](const size_t f) {
+            return segments[f]->getColData()[timestepColNo].getValues()
+                .front();
+        };
+        std::stable_sort(order.begin(), order.end(),
+            [&firstTimestep](const size_t f1, const size_t f2) {
+                return firstTimestep(f1) < firstTimestep(f2);
+            });
+        double timestepNext{numeric_limits<double>::infinity()};
+        for (size_t k=fileTotal; k-- > 0; ) {
+            const ColSpan<double> timesteps{
+                segments[order[k]]->getColData()[timestepColNo].getValues()
+            };
+            rowsKept[order[k]] = std::find_if(timesteps.cbegin(),
+                timesteps.cend(), [timestepNext](const double timestep) {
+                    return timestep >= timestepNext;
+                }) - timesteps.cbegin();
+            timestepNext = std::min(timestepNext, timesteps.front());
+        }
+    }
+
+    // Merge and store the columns -------------------------------------------//
+    cout << "\rIn progress: Processing column data..." << flush;
+    const size_t dataRowTotal{
+        accumulate(rowsKept.cbegin(), rowsKept.cend(), size_t{0})
+    };
+    vector<ColumnBuffer> colData{createColumnBuffers(intColCandidates)};
+    ColumnArena& arena{Table::getCurrent().getArena()};
+    for (int c=0; c<dataColTotal; ++c) {
+        if (segments[0]->getColData()[c].empty()) { continue; }
+        if (intColCandidates[c])    { colData[c].reserve(dataRowTotal); }
+        else                        { arena.place(colData[c], dataRowTotal); }
+        for (const size_t f : order) {
+            colData[c].append(segments[f]->getColData()[c], rowsKept[f]);
+        }
+    }
+    storeMappedColumns(colNames, colData, intColCandidates,
+        segments[0]->getSelectedCols());
+    cout << '\r' << string(38, ' ') << "\n" << flush;
+
+    IntV* dataTimestepIVP{nullptr};
+    if (!IntV::getSetP().empty()) {
+        dataTimestepIVP = IntV::getOneP(0);
+    }
+    LoadStats loadStats{0, 0};
+    for (const std::unique_ptr<FileSegment>& segment : segments) {
+        loadStats.fileSize += segment->getFileSize();
+    }
+    loadStats.bytesScanned = loadStats.fileSize;
+    loadStats.fileTotal = fileTotal;
+
+    return {segments[0]->getDataDlmType(), dataColTotal, dataRowTotal,
+            dataTimestepIVP, DoubleV::getSetP(), loadStats};
+}
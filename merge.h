@@ -0,0 +1,56 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        merge.h
+ * @brief       Load several input files, such as the files of the restarts of
+ *              a run, in parallel and merge them into one set of columns by
+ *              their timesteps.
+ */
+
+#ifndef MERGE_H
+#define MERGE_H
+
+#include "namespaces.h"
+#include "errorMsgs.h"
+
+//----------------------------------------------------------------------------//
+//*********************** ColData::FileSegment Class *************************//
+//----------------------------------------------------------------------------//
+/*
+ * One of the input files that are merged, whose header and data are parsed
+ * into its own columns, without creating the column vectors. Every column that
+ * could be the timestep column is parsed, so that the timestep column can be
+ * chosen from all the files.
+ */
+class ColData::FileSegment {
+  private:
+    const string            m_fileName;
+    size_t                  m_fileSize{0};
+    Delimitation            m_dataDlmType{Delimitation::undefined};
+    vector<string>          m_colNames{};
+    vector<bool>            m_intColCandidates{};
+    vector<bool>            m_selectedCols{};
+    vector<ColumnBuffer>    m_colData{};
+    size_t                  m_dataRowTotal{0};
+
+    FileSegment() = delete;
+    FileSegment(const FileSegment&) = delete;
+    FileSegment& operator=(const FileSegment&) = delete;
+
+  public:
+    explicit FileSegment(const string& fileName);
+
+    void parse(const string& dlm, const LoadOptions& loadOptions);
+
+    size_t getFileSize() const;
+    Delimitation getDataDlmType() const;
+    const vector<string>& getColNames() const;
+    const vector<bool>& getIntColCandidates() const;
+    const vector<bool>& getSelectedCols() const;
+    vector<ColumnBuffer>& getColData();
+    size_t getDataRowTotal() const;
+};
+
+#endif
@@ -17,6 +17,7 @@
 #include <string>
 #include <string_view>
 #include <vector>
+#include <unordered_map>
 #include <complex>
 #include <tuple>
 #include <set>
@@ -25,7 +26,12 @@
 #include <numeric>
 #include <iterator>
 #include <cstddef>
+#include <cstdint>
 #include <cmath>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <exception>
 
 using   std::string, std::vector, std::set, std::tuple, std::unordered_map,
         std::numeric_limits, std::tie, std::get, std::ios_base, std::to_string,
@@ -48,6 +54,21 @@ enum class Delimitation { undefined, spaced, delimited, spacedAndDelimited };
 
 namespace ColData {
     inline constexpr int fftValuesToPrint = 5;
+    inline constexpr size_t minChunkBytes = 1 << 16;
+    inline constexpr unsigned maxThreads = 256;
+    inline constexpr size_t classifySampleBytes = 1 << 16;
+    inline constexpr size_t indexRowInterval = 1024;
+    inline constexpr size_t cacheAlignment = 64;
+    inline constexpr size_t arenaChunkBytes = 1 << 26;
+    inline constexpr size_t hugePageBytes = 1 << 21;
+    inline constexpr size_t zoneBlockRows = 1 << 16;
+    inline constexpr size_t extremaBlockRows = 1 << 8;
+    inline constexpr size_t pipeBlockBytes = 1 << 20;
+    inline constexpr size_t pipeQueueBlocks = 4;
+    inline constexpr size_t readAheadBlockBytes = 1 << 24;
+    inline constexpr size_t readAheadQueueBlocks = 1;
+    enum class Compression { none, gzip, zstd };
+    inline const string stdinFileName{"-"};
     struct CycleData {
         int cycleCount;
         size_t rowInitial;
@@ -59,30 +80,199 @@ namespace ColData {
     };
     CycleData calculateCycleData(const vector<double>& crests,
         const vector<double>& troughs, vector<double>& peaks);
+    struct ZoneStats {          // of a block of zoneBlockRows rows of a column
+        double sum, sumOfSquares, sumOfCubes;
+    };
+    struct RangeExtrema {       // of a range of rows of a column
+        double min, max, absMin;
+    };
+    struct PrefixMoments {      // of the shifted rows before a row of a column
+        double sums[3];         // of their first, second and third powers
+        double errors[3];       // compensation of the sums
+    };
+    class RowIndex;
+    struct LoadOptions {
+        bool mapped{false};
+        bool streamed{false};
+        bool followed{false};       // the streamed file is followed as it grows
+        unsigned followSeconds{1};  // interval between checks of its size
+        unsigned threads{1};
+        bool projected{false};      // only the selected columns are loaded
+        set<int> colNos{};
+        set<string> colNames{};
+        bool windowed{false};       // only a window of the rows is loaded
+        bool rowBgnDefined{false}, rowEndDefined{false};
+        size_t rowBgn{0}, rowEnd{0};
+        bool timestepBgnDefined{false}, timestepEndDefined{false};
+        size_t timestepBgn{0}, timestepEnd{0};
+        bool indexed{false};        // the sidecar index is used or built
+        bool cached{false};         // the column cache is used or written
+        bool floatStored{false};    // the data columns are stored as float
+        bool lazy{false};           // columns are decoded when first used
+        size_t readAheadBytes{0};   // blocks read ahead of the parser, if any
+        bool hugePages{false};      // the columns are held in huge pages
+        bool prefixSums{false};     // range sums are taken from prefix sums
+        const RowIndex* rowIndexP{nullptr};     // valid index of the file
+    };
+    struct LoadStats {
+        size_t fileSize;
+        size_t bytesScanned;
+        bool windowed{false};       // the rows loaded are a window of the file
+        size_t rowOffset{0};        // first row of the window
+        size_t fileRowTotal{0};     // rows of the file, if found from its index
+        bool partial{false};        // there are more rows after the window
+        tuple<bool, size_t, size_t> timestepRange{false, 0, 0}; // of the file
+        size_t fileTotal{1};        // input files merged into the columns
+    };
+    template<typename T> class ColSpan;
     class DoubleV;
     class IntV;
-    const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&> loadData(
-        const string& fileName, const string& dlm);
+    class ColumnArena;
+    class ColumnBuffer;
+    class Table;
+    class MappedFile;
+    class FixedWidthRows;
+    class ColumnSource;
+    class ColumnCache;
+    class BlockQueue;
+    class PipedInput;
+    class FileSegment;
+    class FieldTokenizer;
+    class FixedFormat;
+    struct ScanMasks {
+        uint64_t newline;
+        uint64_t dlm;
+        uint64_t space;
+    };
+    class RowScanner;
+    class RowCounter;
+    struct StreamStats {
+        size_t count{0};
+        double min{0.0}, max{0.0}, absMin{0.0}, absMax{0.0};
+        double sum{0.0}, sumOfSquares{0.0}, sumOfCubes{0.0};
+        double mean{0.0}, sumOfSquaresOfDifference{0.0};
+        void add(const double x);
+    };
+    struct StreamQuery {
+        bool rowBgnDefined, rowEndDefined;
+        size_t rowBgn, rowEnd;
+        bool timestepBgnDefined, timestepEndDefined;
+        size_t timestepBgn, timestepEnd;
+        int cycleColNo{-1};
+        int cycles{-1};
+        double center{0.0}, minAmplitude{0.0};
+        size_t minRowInterval{0};
+        int simTimeColNo{-1};
+    };
+    struct StreamResult {
+        size_t dataRowTotal;
+        tuple<bool, size_t, size_t> timestepRange;
+        bool rowRangeFound;
+        size_t rowBgn, rowEnd;
+        size_t timestepBgn, timestepEnd;
+        double simTimeBgn, simTimeEnd;
+        bool cycleInitialFound;
+        CycleData cycleData;
+    };
+    class StreamV;
+    class CycleStream;
+    class DataStream;
+    ScanMasks scanBlock(const char* block, const char dlm);
+    const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+        loadData(const string& fileName, const string& dlm,
+            const LoadOptions& loadOptions);
+    const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+        loadIndexedData(const string& fileName, const string& dlm,
+            const LoadOptions& loadOptions);
+    const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+        loadCachedData(const string& fileName, const string& dlm,
+            const LoadOptions& loadOptions);
+    bool readLine(ifstream& iFile, string& line);
     bool isNumberLine(stringV lineStr, string dlm);
     tuple<size_t, streampos, streampos> findLinePositions(ifstream& iFile,
         const string& dlm);
     tuple<string, Delimitation> parseHeaderLine(ifstream& iFile,
         const string& dlm, const streampos headerLinePos);
+    tuple<string, Delimitation> parseHeaderLine(string iLine,
+        const string& dlm);
     tuple<int, vector<string>> identifyColumnHeaders(string headerLine,
         const string& dlm, const Delimitation headerDlmType);
     set<int> findTimestepColCandidates(int dataColTotal,
         vector<string> colNames);
+    int findTimestepColFromRow(stringV line, const string& dlm,
+        const Delimitation dataDlmType, const int dataColTotal,
+        const set<int>& timestepColCandidates);
     Delimitation parseColumnData(ifstream& iFile, const string& dlm,
         const streampos dataLinePos);
-    void classifyColumns(ifstream& iFile, const string& dlm,
+    Delimitation parseColumnData(stringV line, const string& dlm);
+    vector<bool> classifyColumns(ifstream& iFile, const string& dlm,
         const Delimitation dataDlmType, const streampos dataLinePos,
-        const int colTotal, set<int>& timestepColCandidates);
+        const int dataColTotal, const set<int>& timestepColCandidates);
     size_t findDataRowTotal(ifstream& iFile, const streampos dataLinePos);
+    vector<bool> selectColumns(const vector<string>& colNames,
+        const LoadOptions& loadOptions);
+    vector<ColumnBuffer> createColumnBuffers(
+        const vector<bool>& intColCandidates);
     void createVectors(const vector<string>& colNames,
-        const size_t dataRowTotal);
-    void populateVectors(ifstream& iFile, const string& dlm,
-        const int dataColTotal, const Delimitation dataDlmType,
-        const streampos dataLinePos, const size_t dataRowTotal);
+        const size_t dataRowTotal, const vector<bool>& selectedCols);
+    size_t populateVectors(ifstream& iFile, const string& dlm,
+        const vector<string>& colNames, const Delimitation dataDlmType,
+        const streampos dataLinePos, const size_t dataRowTotal,
+        const vector<bool>& selectedCols, vector<bool>& intColCandidates);
+    const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+        loadMappedData(const string& fileName, const string& dlm,
+            const LoadOptions& loadOptions);
+    Compression findCompression(const char* data, const size_t size);
+    Compression findCompression(const string& fileName);
+    const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+        loadPipedData(const string& fileName, const string& dlm,
+            const LoadOptions& loadOptions);
+    const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+        loadMergedData(const vector<string>& fileNames, const string& dlm,
+            const LoadOptions& loadOptions);
+    int64_t findFileTime(const string& fileName);
+    bool isBlankLine(stringV line);
+    stringV findMappedLine(const MappedFile& map, const size_t offset);
+    tuple<stringV, stringV, size_t> findMappedLines(stringV fileView,
+        const string& dlm);
+    vector<bool> classifyMappedColumns(const char* bgn, const char* end,
+        const string& dlm, const Delimitation dataDlmType,
+        const int dataColTotal, const set<int>& timestepColCandidates);
+    void parseDataRow(const vector<stringV>& fields, const int dataColTotal,
+        const vector<bool>& parsedCols, vector<FixedFormat>& formats,
+        vector<ColumnBuffer>& colData, vector<bool>& intColCandidates);
+    size_t parseMappedLines(const char* bgn, const char* end,
+        const string& dlm, const Delimitation dataDlmType,
+        const int dataColTotal, const vector<bool>& parsedCols,
+        vector<ColumnBuffer>& colData, vector<bool>& intColCandidates);
+    size_t parseFixedLines(const FixedWidthRows& fixedRows, const char* bgn,
+        const char* end, const string& dlm, const Delimitation dataDlmType,
+        const int dataColTotal, const vector<bool>& parsedCols,
+        vector<ColumnBuffer>& colData, vector<bool>& intColCandidates);
+    vector<const char*> splitMappedLines(const char* bgn, const char* end,
+        const unsigned chunkTotal);
+    size_t parseMappedChunks(const char* bgn, const char* end,
+        const string& dlm, const Delimitation dataDlmType,
+        const int dataColTotal, ColumnArena* arenaP,
+        const unsigned threads, const FixedWidthRows* fixedRowsP,
+        const vector<bool>& parsedCols, vector<ColumnBuffer>& colData,
+        vector<bool>& intColCandidates);
+    bool readMappedTimestep(stringV line, const string& dlm,
+        const Delimitation dataDlmType, const int timestepColNo,
+        size_t& timestep);
+    const char* findMappedRow(const char* bgn, const char* end,
+        const char* pos);
+    stringV findMappedLastLine(const char* bgn, const char* end);
+    const char* findMappedTimestep(const char* bgn, const char* end,
+        const string& dlm, const Delimitation dataDlmType,
+        const int timestepColNo, const size_t timestep, size_t& bytesScanned);
+    tuple<const char*, const char*> findMappedWindow(const char* bgn,
+        const char* end, const string& dlm, const Delimitation dataDlmType,
+        const int timestepColNo, const LoadOptions& loadOptions,
+        LoadStats& loadStats);
+    void storeMappedColumns(const vector<string>& colNames,
+        vector<ColumnBuffer>& colData, const vector<bool>& intColCandidates,
+        const vector<bool>& selectedCols);
 }
 
 //----------------------------------------------------------------------------//
@@ -91,7 +281,9 @@ namespace ColData {
 
 namespace CmdArgs {
     enum class Option { delimiter, fileIn, calculation, column, row, timestep,
-        cycle, fourier, fileOut, printData, fileData, help, version };
+        cycle, fourier, fileOut, printData, fileData, mmap, threads, stream,
+        follow, index, cache, precision, lazy, readAhead, hugePages, prefixSums,
+        help, version };
     enum class CalcId { findMin, findMax, findAbsMin, findAbsMax, findMean,
         findRMS, findFluctuationRMS, findCubicMean, findFourier };
     enum class CycleInit { first, last, full, empty };
@@ -107,6 +299,7 @@ namespace CmdArgs {
     class FileOut;
     class PrintData;
     class FileData;
+    class Loader;
     class Help;
     class Version;
     extern const unordered_map<string, Option> mapStrToOption;
@@ -119,7 +312,6 @@ namespace CmdArgs {
 //----------------------------------------------------------------------------//
 
 namespace CalcFnc {
-    template<typename T> const unordered_map<calcType, string> mapCalcToStr;
     template<typename T> double findMax(const T column,
         const size_t rowBgn, const size_t rowEnd);
     template<typename T> double findMin(const T column,
@@ -149,19 +341,23 @@ namespace Output {
     void printInputDataInfo(const string& fileInName, const int dataColTotal,
         const size_t dataRowTotal, const Delimitation dataDlmType,
         const ColData::IntV* dataTimestepIVP,
-        const vector<ColData::DoubleV*> dataDoubleVSetP);
+        const tuple<bool, size_t, size_t> dataTimestepRange,
+        const vector<ColData::DoubleV*> dataDoubleVSetP,
+        const ColData::LoadStats& loadStats);
     void printer(
-        const tuple<size_t, size_t> rowRange,
+        const tuple<size_t, size_t> rowRange, const size_t rowOffset,
         const bool timestepConsistent, const tuple<size_t,size_t> timestepRange,
         const vector<int>& doubleColSet,
         const vector<CmdArgs::CalcId>& calcIdSet,
-        const CmdArgs::Cycle* cycleP, const CmdArgs::Calc* calcP);
+        const CmdArgs::Cycle* cycleP, const CmdArgs::Calc* calcP,
+        const bool streamed);
     void filer(const string& fileOutName, const string& fileInName,
-        const tuple<size_t, size_t> rowRange,
+        const tuple<size_t, size_t> rowRange, const size_t rowOffset,
         const bool timestepConsistent, const tuple<size_t,size_t> timestepRange,
         const vector<int>& doubleColSet,
         const vector<CmdArgs::CalcId>& calcIdSet,
-        const CmdArgs::Cycle* cycleP, const CmdArgs::Calc* calcP);
+        const CmdArgs::Cycle* cycleP, const CmdArgs::Calc* calcP,
+        const bool streamed);
     void cyclePeaksFiler(const CmdArgs::Cycle* cycleP);
     void fourierCalc(const CmdArgs::Fourier* fourierP);
     void fourierFiler(const string& fileOutName, const size_t outputLen,
@@ -174,8 +370,6 @@ namespace Output {
         const tuple<size_t, size_t> rowRange,
         const bool timestepConsistent, const ColData::IntV* dataTimestepIVP,
         const vector<int>& doubleColSet);
-    template<typename T> const unordered_map<CmdArgs::CalcId, calcType>
-        mapCalcIdToCalc;
 }
 
 #endif
\ No newline at end of file
@@ -31,8 +31,11 @@ void Output::output(CmdArgs::Args* argsP) {
         argsP->getRowP()->getDataRowTotal(),
         argsP->getFileInP()->getDataDlmType(),
         argsP->getTimestepP()->getDataTimestepIVP(),
-        argsP->getColumnP()->getDataDoubleVSetP()
+        argsP->getTimestepP()->getDataTimestepRange(),
+        argsP->getColumnP()->getDataDoubleVSetP(),
+        argsP->getFileInP()->getLoadStats()
     );
+    const bool streamed{argsP->getLoaderP()->getLoadOptions().streamed};
 
     // cout.setf(ios_base::scientific);
     cout.precision(numeric_limits<double>::max_digits10);
@@ -41,12 +44,14 @@ void Output::output(CmdArgs::Args* argsP) {
         if (!argsP->getFileOutP()) {
             printer(
                 argsP->getRowP()->getRange(),
+                argsP->getRowP()->getDataRowOffset(),
                 argsP->getTimestepP()->isTimestepConsistent(),
                 argsP->getTimestepP()->getRange(),
                 argsP->getColumnP()->getDataDoubleColSet(),
                 argsP->getCalcP()->getCalcIdSet(),
                 argsP->getCycleP(),
-                argsP->getCalcP()
+                argsP->getCalcP(),
+                streamed
             );
         }
         else {
@@ -54,12 +59,14 @@ void Output::output(CmdArgs::Args* argsP) {
                 filer(
                     fileOut, argsP->getFileInP()->getFileLocation(),
                     argsP->getRowP()->getRange(),
+                    argsP->getRowP()->getDataRowOffset(),
                     argsP->getTimestepP()->isTimestepConsistent(),
                     argsP->getTimestepP()->getRange(),
                     argsP->getColumnP()->getDataDoubleColSet(),
                     argsP->getCalcP()->getCalcIdSet(),
                     argsP->getCycleP(),
-                    argsP->getCalcP()
+                    argsP->getCalcP(),
+                    streamed
                 );
                 cout<< "\nThe calculation data output has been written to \""
                     << fileOut << "\"" << endl;
@@ -107,23 +114,41 @@ void Output::output(CmdArgs::Args* argsP) {
 void Output::printInputDataInfo(const string& fileInName,
         const int dataColTotal, const size_t dataRowTotal,
         const Delimitation dataDlmType, const ColData::IntV* dataTimestepIVP,
-        const vector<ColData::DoubleV*> dataDoubleVSetP) {
+        const tuple<bool, size_t, size_t> dataTimestepRange,
+        const vector<ColData::DoubleV*> dataDoubleVSetP,
+        const ColData::LoadStats& loadStats) {
     cout<< left << '\n' << string(55, '=') << "\n "
         << "Input file: " << fileInName << '\n' << string(55, '=') << "\n\n"
         << setw(20) << " Total columns:" << dataColTotal << '\n'
-        << setw(20) << " Total rows:" << dataRowTotal
-        << '\n' << setw(20) << " Data delimitation:"
+        << setw(20) << " Total rows:";
+    if (loadStats.fileRowTotal > 0) { cout<< loadStats.fileRowTotal; }
+    else if (loadStats.partial) { cout<< "not counted"; }
+    else { cout<< loadStats.rowOffset + dataRowTotal; }
+    if (loadStats.fileTotal > 1) {
+        cout<< '\n' << setw(20) << " Files merged:" << loadStats.fileTotal;
+    }
+    if (loadStats.windowed) {
+        cout<< '\n' << setw(20) << " Rows loaded:" << loadStats.rowOffset
+            << " to " << loadStats.rowOffset + dataRowTotal - 1;
+    }
+    cout<< '\n' << setw(20) << " Data delimitation:"
         << ((dataDlmType == Delimitation::delimited) ? "delimiter" :
             ((dataDlmType == Delimitation::spacedAndDelimited) ?
-                "whitespace and delimiter" : "whitespace")) << '\n' << endl;
+                "whitespace and delimiter" : "whitespace"))
+        << '\n' << setw(20) << " Bytes scanned:" << loadStats.bytesScanned;
+    if (loadStats.fileSize > 0) {
+        cout<< " (" << static_cast<double>(loadStats.bytesScanned)
+                        /loadStats.fileSize << " x file size)";
+    }
+    cout<< '\n' << endl;
 
-    if (dataTimestepIVP && get<0>(dataTimestepIVP->getTimestepRange())) {
+    if (dataTimestepIVP && get<0>(dataTimestepRange)) {
         cout<< " Timestep column:\n" << string(30, '-') << '\n'
             << setw(3) << right << dataTimestepIVP->getColNo() << ". "
             << left << dataTimestepIVP->getColName() << '\n'
             << "\n Available timestep range is from "
-            << get<1>(dataTimestepIVP->getTimestepRange()) << " to "
-            << get<2>(dataTimestepIVP->getTimestepRange()) << ".\n\n";
+            << get<1>(dataTimestepRange) << " to "
+            << get<2>(dataTimestepRange) << ".\n\n";
     }
     else {
         cout<< " No consistent timestep column was found.\n\n";
@@ -145,12 +170,13 @@ void Output::printInputDataInfo(const string& fileInName,
  * results to the terminal.
  */
 void Output::printer(
-        const tuple<size_t, size_t> rowRange,
+        const tuple<size_t, size_t> rowRange, const size_t rowOffset,
         const bool timestepConsistent,
         const tuple<size_t,size_t> timestepRange,
         const vector<int>& doubleColSet,
         const vector<CmdArgs::CalcId>& calcIdSet,
-        const CmdArgs::Cycle* cycleP, const CmdArgs::Calc* calcP) {
+        const CmdArgs::Cycle* cycleP, const CmdArgs::Calc* calcP,
+        const bool streamed) {
     size_t rBgn, rEnd, tBgn, tEnd;
     tie(rBgn, rEnd) = rowRange;
     tie(tBgn, tEnd) = timestepRange;
@@ -162,7 +188,8 @@ void Output::printer(
             << to_string(tBgn) << " to " << to_string(tEnd);
     }
     cout<< "\n Rows              => "
-        << to_string(rBgn) << " to " << to_string(rEnd);
+        << to_string(rowOffset + rBgn) << " to "
+        << to_string(rowOffset + rEnd);
     if (cycleP) {
         int cycleCount{cycleP->getInputCount()};
         ColData::CycleData cData{cycleP->getCalcCycleData()};
@@ -204,8 +231,11 @@ void Output::printer(
             for (const CmdArgs::CalcId id : calcIdSet) {
                 calcType calc{mapCalcIdToCalc<int>.at(id)};
                 cout<< ' ' << left << setw(22)
-                    << CalcFnc::mapCalcToStr<int>.at(calc)
-                    << " = " << calc(colNo, rBgn, rEnd) << '\n';
+                    << CalcFnc::mapCalcToStr<int>.at(calc) << " = "
+                    << (streamed ?
+                        StreamV::getOnePFromCol(colNo)->findCalc(id) :
+                        calc(colNo, rBgn, rEnd))
+                    << '\n';
             }
         }
         cout<< '\n' << string(55, '=') << endl;
@@ -217,12 +247,13 @@ void Output::printer(
  * results to the terminal.
  */
 void Output::filer(const string& fileOutName,  const string& fileInName,
-        const tuple<size_t, size_t> rowRange,
+        const tuple<size_t, size_t> rowRange, const size_t rowOffset,
         const bool timestepConsistent,
         const tuple<size_t,size_t> timestepRange,
         const vector<int>& doubleColSet,
         const vector<CmdArgs::CalcId>& calcIdSet,
-        const CmdArgs::Cycle* cycleP, const CmdArgs::Calc* calcP) {
+        const CmdArgs::Cycle* cycleP, const CmdArgs::Calc* calcP,
+        const bool streamed) {
     size_t rBgn, rEnd, tBgn, tEnd;
     tie(rBgn, rEnd) = rowRange;
     tie(tBgn, tEnd) = timestepRange;
@@ -240,7 +271,8 @@ void Output::filer(const string& fileOutName,  const string& fileInName,
             << to_string(tBgn) << " to " << to_string(tEnd);
     }
     fOut<< "\nRows              => "
-        << to_string(rBgn) << " to " << to_string(rEnd);
+        << to_string(rowOffset + rBgn) << " to "
+        << to_string(rowOffset + rEnd);
     if (cycleP) {
         int cycleCount{cycleP->getInputCount()};
         ColData::CycleData cData{cycleP->getCalcCycleData()};
@@ -287,7 +319,10 @@ void Output::filer(const string& fileOutName,  const string& fileInName,
             calcType calc{mapCalcIdToCalc<int>.at(id)};
             fOut << '\n' << CalcFnc::mapCalcToStr<int>.at(calc) << ',';
             for (const int colNo : doubleColSet) {
-                fOut << calc(colNo, rBgn, rEnd) << ',';
+                fOut<< (streamed ?
+                        StreamV::getOnePFromCol(colNo)->findCalc(id) :
+                        calc(colNo, rBgn, rEnd))
+                    << ',';
             }
         }
         fOut<< '\n' << string(70, '`') << '\n';
@@ -330,7 +365,7 @@ void Output::fourierCalc(const CmdArgs::Fourier* fourierP) {
         signalLen{sampleFreq},                  // L
         outputLen{(signalLen/2)+1};
     DoubleV* fourierColDVP{DoubleV::getOnePFromCol(fourierP->getColNo())};
-    vector<double> fourierColData{fourierColDVP->getData()};
+    vector<double> fourierColData(fourierColDVP->copyData());
     vector<std::complex<double>> fftData;
     vector<double> fftMag;
     fftData.reserve(signalLen);
@@ -433,8 +468,10 @@ void Output::dataPrinter(const string& dlm,
     if (timestepConsistent) {
         cout << dataTimestepIVP->getColName() << dlm;
     }
+    vector<const DoubleV*> colDVPs;
     for (const int colNo : doubleColSet) {
-        cout << DoubleV::getOnePFromCol(colNo)->getColName() << dlm;
+        colDVPs.push_back(DoubleV::getOnePFromCol(colNo));
+        cout << colDVPs.back()->getColName() << dlm;
     }
     cout << '\n';
 
@@ -444,8 +481,8 @@ void Output::dataPrinter(const string& dlm,
         if (timestepConsistent) {
             cout << dataTimestepIVP->getData()[row] << dlm;
         }
-        for (const int colNo : doubleColSet) {
-            cout << DoubleV::getOnePFromCol(colNo)->getData()[row] << dlm;
+        for (const DoubleV* dVP : colDVPs) {
+            cout << dVP->getValue(row) << dlm;
         }
         cout << '\n';
     }
@@ -467,8 +504,10 @@ void Output::dataFiler(const string& fileName, const string& dlm,
     if (timestepConsistent) {
         fOut << dataTimestepIVP->getColName() << dlm;
     }
+    vector<const DoubleV*> colDVPs;
     for (const int colNo : doubleColSet) {
-        fOut << DoubleV::getOnePFromCol(colNo)->getColName() << dlm;
+        colDVPs.push_back(DoubleV::getOnePFromCol(colNo));
+        fOut << colDVPs.back()->getColName() << dlm;
     }
     fOut << '\n';
 
@@ -478,8 +517,8 @@ void Output::dataFiler(const string& fileName, const string& dlm,
         if (timestepConsistent) {
             fOut << dataTimestepIVP->getData()[row] << dlm;
         }
-        for (const int colNo : doubleColSet) {
-            fOut << DoubleV::getOnePFromCol(colNo)->getData()[row] << dlm;
+        for (const DoubleV* dVP : colDVPs) {
+            fOut << dVP->getValue(row) << dlm;
         }
         fOut << '\n';
     }
@@ -0,0 +1,409 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        pipe.cpp
+ * @brief       Read the input file on a separate thread as a sequence of
+ *              blocks, decompressing it if it is compressed, and load the
+ *              column data from the blocks as they arrive.
+ */
+
+#include <memory>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+#ifdef COLDATAUTIL_ZSTD
+#include <zstd.h>
+#endif
+
+#include "namespaces.h"
+#include "colData.h"
+#include "pipe.h"
+#include "errorMsgs.h"
+
+using namespace ColData;
+
+//----------------------------------------------------------------------------//
+//************************ ColData::BlockQueue Class *************************//
+//----------------------------------------------------------------------------//
+BlockQueue::BlockQueue(const size_t capacity) : m_capacity{capacity} {}
+
+/*
+ * Add a block to the queue, waiting while it is full. Return false if the
+ * queue has been closed, in which case the reader should stop.
+ */
+bool BlockQueue::push(vector<char>&& block) {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_popped.wait(lock, [this]() {
+        return m_closed || m_blocks.size() < m_capacity;
+    });
+    if (m_closed) { return false; }
+    m_blocks.push_back(std::move(block));
+    m_pushed.notify_one();
+    return true;
+}
+
+/*
+ * Take the next block from the queue, waiting while it is empty. Return false
+ * if the queue has been closed and emptied, or rethrow the error that closed
+ * it.
+ */
+bool BlockQueue::pop(vector<char>& block) {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_pushed.wait(lock, [this]() { return m_closed || !m_blocks.empty(); });
+    if (m_blocks.empty()) {
+        if (m_error) { std::rethrow_exception(m_error); }
+        return false;
+    }
+    block = std::move(m_blocks.front());
+    m_blocks.pop_front();
+    m_popped.notify_one();
+    return true;
+}
+
+/*
+ * Close the queue, after which no block is added to it, with the error of the
+ * reader if it has failed.
+ */
+void BlockQueue::close(std::exception_ptr error) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (m_closed) { return; }
+    m_closed = true;
+    m_error = error;
+    m_pushed.notify_all();
+    m_popped.notify_all();
+}
+
+//----------------------------------------------------------------------------//
+//************************ ColData::PipedInput Class *************************//
+//----------------------------------------------------------------------------//
+PipedInput::PipedInput(const string& fileName, const size_t blockBytes,
+        const size_t queueBlocks) :
+  m_fileName{fileName}, m_blockBytes{blockBytes}, m_queue{queueBlocks} {
+    m_reader = std::thread{&PipedInput::read, this};
+}
+PipedInput::~PipedInput() {
+    m_queue.close();
+    m_reader.join();
+    if (m_fd >= 0) { close(m_fd); }
+}
+
+bool PipedInput::next(vector<char>& block) { return m_queue.pop(block); }
+
+/*
+ * Give a block that has been parsed back to the reader, to be read into again.
+ */
+void PipedInput::giveBack(vector<char>&& block) {
+    std::lock_guard<std::mutex> lock{m_spareMutex};
+    m_spareBlocks.push_back(std::move(block));
+}
+
+/*
+ * Return the number of bytes read from the input, which is final once the
+ * last block has been taken.
+ */
+size_t PipedInput::getInputBytes() const { return m_inputBytes; }
+
+/*
+ * Read the input file, or the standard input, on the reader thread and close
+ * the queue at its end, or with the error that stopped it. The first block is
+ * read before the compression is known, and is then passed on to be copied or
+ * decompressed.
+ */
+void PipedInput::read() {
+    try {
+        if (m_fileName != stdinFileName) {
+            m_fd = open(m_fileName.c_str(), O_RDONLY);
+            if (m_fd < 0) { throw runtime_error(errorInputFile); }
+            posix_fadvise(m_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        }
+        vector<char> in(m_blockBytes);
+        const size_t inSize{readBlock(in)};
+        switch (findCompression(in.data(), inSize)) {
+            case Compression::gzip: inflateGzip(in, inSize);    break;
+            case Compression::zstd: inflateZstd(in, inSize);    break;
+            default:                copyBlocks(in, inSize);     break;
+        }
+        m_queue.close();
+    }
+    catch (...) { m_queue.close(std::current_exception()); }
+}
+
+/*
+ * Take a block that has been given back, or a new one, of the block size.
+ */
+vector<char> PipedInput::takeBlock() {
+    vector<char> block;
+    {
+        std::lock_guard<std::mutex> lock{m_spareMutex};
+        if (!m_spareBlocks.empty()) {
+            block = std::move(m_spareBlocks.back());
+            m_spareBlocks.pop_back();
+        }
+    }
+    block.resize(m_blockBytes);
+    return block;
+}
+
+/*
+ * Read the next block of the input into the given buffer, and return its size,
+ * which is less than the size of the buffer only at the end of the input.
+ */
+size_t PipedInput::readBlock(vector<char>& in) {
+    size_t inSize{0};
+    if (m_fd < 0) {
+        std::cin.read(in.data(), in.size());
+        inSize = static_cast<size_t>(std::cin.gcount());
+    }
+    while (m_fd >= 0 && inSize < in.size()) {
+        const ssize_t bytes{pread(m_fd, in.data() + inSize, in.size() - inSize,
+            static_cast<off_t>(m_inputBytes + inSize))};
+        if (bytes < 0 && errno == EINTR) { continue; }
+        if (bytes < 0) { throw runtime_error(errorInputFile); }
+        if (bytes == 0) { break; }
+        inSize += static_cast<size_t>(bytes);
+    }
+    m_inputBytes += inSize;
+    return inSize;
+}
+
+/*
+ * Pass on an uncompressed input as it is read, starting with the given block.
+ */
+void PipedInput::copyBlocks(vector<char>& in, size_t inSize) {
+    while (inSize > 0) {
+        in.resize(inSize);
+        if (!m_queue.push(std::move(in))) { return; }
+        in = takeBlock();
+        inSize = readBlock(in);
+    }
+}
+
+/*
+ * Decompress a gzip input, which may have several members, into blocks,
+ * starting with the given block of the input.
+ */
+void PipedInput::inflateGzip(vector<char>& in, size_t inSize) {
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {   // gzip or zlib header
+        throw runtime_error(errorDecompress);
+    }
+    const std::unique_ptr<z_stream, int(*)(z_streamp)> guard{&stream,
+        inflateEnd};
+    vector<char> out{takeBlock()};
+    size_t outUsed{0};
+    int status{Z_OK};
+    stream.avail_in = static_cast<uInt>(inSize);
+    stream.next_in = reinterpret_cast<Bytef*>(in.data());
+
+    while (true) {
+        if (stream.avail_in == 0) {
+            stream.avail_in = static_cast<uInt>(readBlock(in));
+            stream.next_in = reinterpret_cast<Bytef*>(in.data());
+            if (stream.avail_in == 0) { break; }
+        }
+        stream.next_out = reinterpret_cast<Bytef*>(out.data() + outUsed);
+        stream.avail_out = static_cast<uInt>(out.size() - outUsed);
+        status = inflate(&stream, Z_NO_FLUSH);
+        if (status == Z_STREAM_END) { inflateReset(&stream); }
+        else if (status != Z_OK) { throw runtime_error(errorDecompress); }
+        outUsed = out.size() - stream.avail_out;
+        if (outUsed == out.size()) {
+            if (!m_queue.push(std::move(out))) { return; }
+            out = takeBlock();
+            outUsed = 0;
+        }
+    }
+    if (status != Z_STREAM_END) { throw runtime_error(errorDecompress); }
+    out.resize(outUsed);
+    if (!out.empty()) { m_queue.push(std::move(out)); }
+}
+
+/*
+ * Decompress a Zstandard input, which may have several frames, into blocks,
+ * starting with the given block of the input. This needs the program to be
+ * built with zstd.
+ */
+void PipedInput::inflateZstd([[maybe_unused]] vector<char>& in,
+        [[maybe_unused]] size_t inSize) {
+#ifdef COLDATAUTIL_ZSTD
+    const std::unique_ptr<ZSTD_DStream, size_t(*)(ZSTD_DStream*)> stream{
+        ZSTD_createDStream(), ZSTD_freeDStream};
+    if (!stream || ZSTD_isError(ZSTD_initDStream(stream.get()))) {
+        throw runtime_error(errorDecompress);
+    }
+    vector<char> out{takeBlock()};
+    size_t outUsed{0}, status{0};
+
+    for (; inSize > 0; inSize = readBlock(in)) {
+        ZSTD_inBuffer inBuffer{in.data(), inSize, 0};
+        bool outFull{true};
+        // The output left in the decoder is drained while the output is full
+        while (inBuffer.pos < inBuffer.size || outFull) {
+            ZSTD_outBuffer output{out.data(), out.size(), outUsed};
+            status = ZSTD_decompressStream(stream.get(), &output, &inBuffer);
+            if (ZSTD_isError(status)) { throw runtime_error(errorDecompress); }
+            outUsed = output.pos;
+            outFull = outUsed == out.size();
+            if (outFull) {
+                if (!m_queue.push(std::move(out))) { return; }
+                out = takeBlock();
+                outUsed = 0;
+            }
+        }
+    }
+    if (status != 0) { throw runtime_error(errorDecompress); }
+    out.resize(outUsed);
+    if (!out.empty()) { m_queue.push(std::move(out)); }
+#else
+    throw runtime_error(errorZstdUnsupported);
+#endif
+}
+
+//----------------------------------------------------------------------------//
+//**************************** Piped data loading ****************************//
+//----------------------------------------------------------------------------//
+/*
+ * Find from the first bytes of a file whether it is compressed, and how.
+ */
+Compression ColData::findCompression(const char* data, const size_t size) {
+    const unsigned char* magic{reinterpret_cast<const unsigned char*>(data)};
+    if (size >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+        return Compression::gzip;
+    }
+    if (size >= 4 && magic[0] == 0x28 && magic[1] == 0xb5
+            && magic[2] == 0x2f && magic[3] == 0xfd) {
+        return Compression::zstd;
+    }
+    return Compression::none;
+}
+Compression ColData::findCompression(const string& fileName) {
+    ifstream iFile{fileName, std::ios::binary};
+    char magic[4]{};
+    iFile.read(magic, sizeof(magic));
+    return findCompression(magic, static_cast<size_t>(iFile.gcount()));
+}
+
+/*
+ * Load the input file from the blocks of a piped input in one forward pass.
+ * The blocks are gathered until the first data line is complete, from which
+ * the header and the data delimitation are found, and then the complete lines
+ * of each block are parsed in place as it arrives, while the next blocks are
+ * being read; only the line that spans two blocks is copied. The whole file is
+ * loaded, since it cannot be seeked; this is also how the standard input is
+ * loaded, of which only the lines up to the first data line and a few blocks
+ * are held at a time. With --read-ahead, an uncompressed file is loaded in the
+ * same way, in blocks of the requested size. Return the same variables as
+ * ColData::loadData().
+ */
+const tuple<Delimitation, int, size_t, IntV*, vector<DoubleV*>&, LoadStats>
+        ColData::loadPipedData(const string& fileName, const string& dlm,
+            const LoadOptions& loadOptions) {
+    PipedInput input{fileName,
+        loadOptions.readAheadBytes ? loadOptions.readAheadBytes
+                                   : pipeBlockBytes,
+        loadOptions.readAheadBytes ? readAheadQueueBlocks : pipeQueueBlocks};
+    cout << "File found. Program initiated." << flush;
+
+    // Gather the lines up to the first data line ----------------------------//
+    string text;
+    vector<char> block;
+    size_t bytesRead{0}, linesEnd{0};
+    bool more{true};
+    auto hasDataLine = [&text, &dlm](const size_t end) {
+        for (size_t pos{0}; pos < end; ) {
+            size_t eol{text.find('\n', pos)};
+            if (eol == string::npos || eol > end) { eol = end; }
+            const stringV line{text.data() + pos, eol - pos};
+            if (!isBlankLine(line) && isNumberLine(line, dlm)) { return true; }
+            pos = eol + 1;
+        }
+        return false;
+    };
+    while (more) {
+        more = input.next(block);
+        text.append(block.data(), block.size());
+        bytesRead += block.size();
+        input.giveBack(std::move(block));
+        const size_t eol{text.rfind('\n')};
+        linesEnd = !more ? text.length() : (eol == string::npos ? 0 : eol + 1);
+        if (hasDataLine(linesEnd)) { break; }
+    }
+
+    // Process the header ----------------------------------------------------//
+    stringV headerLine, dataLine;
+    size_t dataOffset;
+    tie(headerLine, dataLine, dataOffset) =
+        findMappedLines(stringV{text.data(), linesEnd}, dlm);
+
+    string headerStr;
+    Delimitation headerDlmType;
+    tie(headerStr, headerDlmType) = parseHeaderLine(string{headerLine}, dlm);
+
+    int dataColTotal;
+    vector<string> colNames;
+    tie(dataColTotal, colNames) =
+        identifyColumnHeaders(headerStr, dlm, headerDlmType);
+
+    vector<bool> intColCandidates(dataColTotal, false);
+    for (int c : findTimestepColCandidates(dataColTotal, colNames)) {
+        intColCandidates[c] = true;
+    }
+    const vector<bool> selectedCols{selectColumns(colNames, loadOptions)};
+    vector<bool> parsedCols(dataColTotal);
+    for (int c=0; c<dataColTotal; ++c) {
+        parsedCols[c] = selectedCols[c] || intColCandidates[c];
+    }
+    const Delimitation dataDlmType{parseColumnData(dataLine, dlm)};
+
+    // Parse the blocks as they arrive ---------------------------------------//
+    cout << "\rIn progress: Parsing column data..." << flush;
+    vector<ColumnBuffer> colData{createColumnBuffers(intColCandidates)};
+    size_t dataRowTotal{
+        parseMappedLines(text.data() + dataOffset, text.data() + linesEnd, dlm,
+            dataDlmType, dataColTotal, parsedCols, colData, intColCandidates)
+    };
+    text.erase(0, linesEnd);
+    text.shrink_to_fit();
+    while (more && (more = input.next(block))) {
+        bytesRead += block.size();
+        const char* blockBgn{block.data()};
+        const char* blockEnd{block.data() + block.size()};
+        const char* firstEol{static_cast<const char*>(
+            std::memchr(blockBgn, '\n', block.size()))};
+        if (!firstEol) {
+            text.append(blockBgn, block.size());
+            input.giveBack(std::move(block));
+            continue;
+        }
+        text.append(blockBgn, firstEol + 1 - blockBgn);
+        dataRowTotal += parseMappedLines(text.data(),
+            text.data() + text.length(), dlm, dataDlmType, dataColTotal,
+            parsedCols, colData, intColCandidates);
+        const char* linesBgn{firstEol + 1};
+        while (blockEnd > linesBgn && *(blockEnd - 1) != '\n') { --blockEnd; }
+        dataRowTotal += parseMappedLines(linesBgn, blockEnd, dlm,
+            dataDlmType, dataColTotal, parsedCols, colData, intColCandidates);
+        text.assign(blockEnd, block.data() + block.size() - blockEnd);
+        input.giveBack(std::move(block));
+    }
+    dataRowTotal += parseMappedLines(text.data(), text.data() + text.length(),
+        dlm, dataDlmType, dataColTotal, parsedCols, colData, intColCandidates);
+    if (dataRowTotal == 0) { throw runtime_error(errorDlmFormatIncorrect); }
+
+    cout << "\rIn progress: Processing column data..." << flush;
+    storeMappedColumns(colNames, colData, intColCandidates, selectedCols);
+    cout << '\r' << string(38, ' ') << "\n" << flush;
+
+    IntV* dataTimestepIVP{nullptr};
+    if (!IntV::getSetP().empty()) {
+        dataTimestepIVP = IntV::getOneP(0);
+    }
+    const LoadStats loadStats{input.getInputBytes(), bytesRead};
+
+    return {dataDlmType, dataColTotal, dataRowTotal, dataTimestepIVP,
+            DoubleV::getSetP(), loadStats};
+}
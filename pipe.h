@@ -0,0 +1,98 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        pipe.h
+ * @brief       Read the input file on a separate thread as a sequence of
+ *              blocks, decompressing it if it is compressed, and load the
+ *              column data from the blocks as they arrive.
+ */
+
+#ifndef PIPE_H
+#define PIPE_H
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+#include "namespaces.h"
+#include "errorMsgs.h"
+
+//----------------------------------------------------------------------------//
+//************************ ColData::BlockQueue Class *************************//
+//----------------------------------------------------------------------------//
+/*
+ * Bounded queue of blocks of bytes between the thread that reads the input
+ * and the thread that parses it. A full queue blocks the reader, and an empty
+ * one blocks the parser. An error of the reader is passed on to the parser
+ * when the blocks before it have been taken.
+ */
+class ColData::BlockQueue {
+  private:
+    const size_t                m_capacity;
+    std::deque<vector<char>>    m_blocks{};
+    std::mutex                  m_mutex{};
+    std::condition_variable     m_pushed{};
+    std::condition_variable     m_popped{};
+    bool                        m_closed{false};
+    std::exception_ptr          m_error{};
+
+    BlockQueue() = delete;
+    BlockQueue(const BlockQueue&) = delete;
+    BlockQueue& operator=(const BlockQueue&) = delete;
+
+  public:
+    explicit BlockQueue(const size_t capacity);
+
+    bool push(vector<char>&& block);
+    bool pop(vector<char>& block);
+    void close(std::exception_ptr error = nullptr);
+};
+
+//----------------------------------------------------------------------------//
+//************************ ColData::PipedInput Class *************************//
+//----------------------------------------------------------------------------//
+/*
+ * Input file that is read, and decompressed if it is compressed, on a reader
+ * thread, which passes it on in blocks of the given size through a queue of
+ * the given number of blocks, so that reading and parsing overlap. A file is
+ * read with pread(), and the blocks that the parser is done with are given
+ * back to be read into again, so that no block is allocated twice. The file
+ * named stdinFileName is the standard input, which may be a pipe; the
+ * compression is found from the first block that is read.
+ */
+class ColData::PipedInput {
+  private:
+    const string                m_fileName;
+    const size_t                m_blockBytes;
+    int                         m_fd{-1};           // -1 for the standard input
+    size_t                      m_inputBytes{0};    // bytes read from the input
+    BlockQueue                  m_queue;
+    std::mutex                  m_spareMutex{};
+    vector<vector<char>>        m_spareBlocks{};
+    std::thread                 m_reader{};
+
+    PipedInput() = delete;
+    PipedInput(const PipedInput&) = delete;
+    PipedInput& operator=(const PipedInput&) = delete;
+
+    void read();
+    vector<char> takeBlock();
+    size_t readBlock(vector<char>& in);
+    void copyBlocks(vector<char>& in, size_t inSize);
+    void inflateGzip(vector<char>& in, size_t inSize);
+    void inflateZstd(vector<char>& in, size_t inSize);
+
+  public:
+    explicit PipedInput(const string& fileName,
+        const size_t blockBytes = pipeBlockBytes,
+        const size_t queueBlocks = pipeQueueBlocks);
+    ~PipedInput();
+
+    bool next(vector<char>& block);
+    void giveBack(vector<char>&& block);
+    size_t getInputBytes() const;
+};
+
+#endif
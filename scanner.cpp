@@ -0,0 +1,298 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        scanner.cpp
+ * @brief       Find the rows and fields of the column data from bitmasks of
+ *              64-byte blocks, which are classified with SIMD instructions
+ *              where the processor supports them.
+ */
+
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCAN_X86
+#endif
+
+#include "namespaces.h"
+#include "scanner.h"
+#include "tokenizer.h"
+
+using namespace ColData;
+
+//----------------------------------------------------------------------------//
+//*************************** Block scanning kernels *************************//
+//----------------------------------------------------------------------------//
+/*
+ * Each kernel classifies the 64 bytes at the given pointer and sets bit i of
+ * each mask if byte i is a newline, the delimiter or whitespace respectively.
+ */
+static ScanMasks scanBlockScalar(const char* block, const char dlm) {
+    ScanMasks masks{0, 0, 0};
+    for (size_t i=0; i<scanBlockBytes; ++i) {
+        const uint64_t bit{uint64_t{1} << i};
+        if (block[i] == '\n') { masks.newline |= bit; }
+        if (block[i] == dlm) { masks.dlm |= bit; }
+        if (FieldTokenizer::isSpace(block[i])) { masks.space |= bit; }
+    }
+    return masks;
+}
+
+#ifdef SCAN_X86
+__attribute__((target("sse4.2")))
+static ScanMasks scanBlockSSE42(const char* block, const char dlm) {
+    const __m128i newline{_mm_set1_epi8('\n')}, delimiter{_mm_set1_epi8(dlm)};
+    const __m128i spaces{_mm_setr_epi8(' ', '\t', '\n', '\v', '\f', '\r',
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0)};
+    ScanMasks masks{0, 0, 0};
+    for (size_t i=0; i<scanBlockBytes; i+=16) {
+        const __m128i bytes{
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i))
+        };
+        const __m128i space{_mm_cmpestrm(spaces, 6, bytes, 16,
+            _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK)};
+        masks.newline |= static_cast<uint64_t>(static_cast<uint16_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)))) << i;
+        masks.dlm |= static_cast<uint64_t>(static_cast<uint16_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, delimiter)))) << i;
+        masks.space |= static_cast<uint64_t>(static_cast<uint16_t>(
+            _mm_cvtsi128_si32(space))) << i;
+    }
+    return masks;
+}
+
+__attribute__((target("avx2")))
+static ScanMasks scanBlockAVX2(const char* block, const char dlm) {
+    const __m256i newline{_mm256_set1_epi8('\n')};
+    const __m256i delimiter{_mm256_set1_epi8(dlm)};
+    const __m256i blank{_mm256_set1_epi8(' ')}, tab{_mm256_set1_epi8('\t')};
+    const __m256i controlRange{_mm256_set1_epi8('\r' - '\t')};
+    ScanMasks masks{0, 0, 0};
+    for (size_t i=0; i<scanBlockBytes; i+=32) {
+        const __m256i bytes{
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i))
+        };
+        // '\t' to '\r' are the bytes whose offset from '\t' is at most 4
+        const __m256i offset{_mm256_sub_epi8(bytes, tab)};
+        const __m256i space{_mm256_or_si256(_mm256_cmpeq_epi8(bytes, blank),
+            _mm256_cmpeq_epi8(_mm256_min_epu8(offset, controlRange), offset))};
+        masks.newline |= static_cast<uint64_t>(static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, newline)))) << i;
+        masks.dlm |= static_cast<uint64_t>(static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, delimiter)))) << i;
+        masks.space |= static_cast<uint64_t>(static_cast<uint32_t>(
+            _mm256_movemask_epi8(space))) << i;
+    }
+    return masks;
+}
+#endif
+
+/*
+ * Select the widest kernel that the processor supports, once at start-up.
+ */
+using ScanKernel = ScanMasks(*)(const char*, const char);
+
+static ScanKernel selectScanKernel() {
+#ifdef SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))     { return scanBlockAVX2; }
+    if (__builtin_cpu_supports("sse4.2"))   { return scanBlockSSE42; }
+#endif
+    return scanBlockScalar;
+}
+
+static const ScanKernel s_scanKernel{selectScanKernel()};
+
+ScanMasks ColData::scanBlock(const char* block, const char dlm) {
+    return s_scanKernel(block, dlm);
+}
+
+/*
+ * Classify up to a block of bytes. A short block is padded with whitespace, and
+ * the bits of the valid bytes are set in the given mask.
+ */
+static ScanMasks scanPartialBlock(const char* bgn, const size_t len,
+        const char dlm, uint64_t& validMask) {
+    if (len == scanBlockBytes) {
+        validMask = ~uint64_t{0};
+        return scanBlock(bgn, dlm);
+    }
+    char block[scanBlockBytes];
+    std::memset(block, ' ', scanBlockBytes);
+    std::memcpy(block, bgn, len);
+    validMask = (uint64_t{1} << len) - 1;
+    return scanBlock(block, dlm);
+}
+
+//----------------------------------------------------------------------------//
+//************************ ColData::RowScanner Class *************************//
+//----------------------------------------------------------------------------//
+RowScanner::RowScanner(const char* bgn, const char* end, stringV dlm,
+        Delimitation dataDlmType) :
+  m_end{end}, m_dlm{dlm}, m_spaced{dataDlmType == Delimitation::spaced},
+  m_block{bgn}, m_next{bgn}, m_fieldBgn{bgn} {}
+
+/*
+ * Classify the next block and set its events: the newlines, and the field
+ * boundaries, which are the delimiters of delimited data or the changes between
+ * whitespace and the rest for spaced data. Return false at the end of the data.
+ */
+bool RowScanner::loadBlock() {
+    if (m_next >= m_end) { return false; }
+    m_block = m_next;
+    const size_t len{
+        std::min(scanBlockBytes, static_cast<size_t>(m_end - m_block))
+    };
+    m_next = m_block + len;
+
+    uint64_t validMask;
+    const ScanMasks masks{scanPartialBlock(m_block, len,
+        m_dlm.empty() ? '\n' : m_dlm[0], validMask)};
+    m_newlines = masks.newline & validMask;
+    if (m_spaced) {
+        const uint64_t prevSpace{(masks.space << 1) | m_prevSpace};
+        m_prevSpace = masks.space >> (scanBlockBytes - 1);
+        m_bounds = (masks.space ^ prevSpace) & validMask;
+    }
+    else {
+        m_bounds = masks.dlm & validMask;
+    }
+    m_events = m_newlines | m_bounds;
+    return true;
+}
+
+/*
+ * Add the field from the current field beginning to the given end, without any
+ * whitespace around it.
+ */
+void RowScanner::addField(vector<stringV>& fields, const char* fieldEnd) const {
+    const char* fieldBgn{m_fieldBgn};
+    while (fieldBgn < fieldEnd && FieldTokenizer::isSpace(*fieldBgn)) {
+        ++fieldBgn;
+    }
+    while (fieldEnd > fieldBgn && FieldTokenizer::isSpace(fieldEnd[-1])) {
+        --fieldEnd;
+    }
+    fields.emplace_back(fieldBgn, static_cast<size_t>(fieldEnd - fieldBgn));
+}
+
+bool RowScanner::nextSpacedRow(vector<stringV>& fields) {
+    while (true) {
+        while (!m_events) {
+            if (!loadBlock()) {
+                if (m_inField) {
+                    addField(fields, m_end);
+                    m_inField = false;
+                }
+                return !fields.empty();
+            }
+        }
+        const unsigned bit{static_cast<unsigned>(__builtin_ctzll(m_events))};
+        const uint64_t mask{uint64_t{1} << bit};
+        const char* pos{m_block + bit};
+        m_events &= m_events - 1;
+
+        if (m_bounds & mask) {
+            if (m_inField) { addField(fields, pos); }
+            else { m_fieldBgn = pos; }
+            m_inField = !m_inField;
+        }
+        if ((m_newlines & mask) && !fields.empty()) { return true; }
+    }
+}
+
+bool RowScanner::nextDelimitedRow(vector<stringV>& fields) {
+    const size_t dlmLen{m_dlm.length()};
+    while (true) {
+        while (!m_events) {
+            if (!loadBlock()) {
+                if (m_fieldBgn < m_end || !fields.empty()) {
+                    addField(fields, m_end);
+                    m_fieldBgn = m_end;
+                    if (fields.size() == 1 && fields[0].empty()) {
+                        fields.clear();
+                    }
+                }
+                return !fields.empty();
+            }
+        }
+        const unsigned bit{static_cast<unsigned>(__builtin_ctzll(m_events))};
+        const uint64_t mask{uint64_t{1} << bit};
+        const char* pos{m_block + bit};
+        m_events &= m_events - 1;
+        if (pos < m_fieldBgn) { continue; } // Inside a delimiter
+
+        if (m_newlines & mask) {
+            addField(fields, pos);
+            m_fieldBgn = pos + 1;
+            if (fields.size() == 1 && fields[0].empty()) {
+                fields.clear(); // Blank row
+                continue;
+            }
+            return true;
+        }
+        if (dlmLen > 1 && (static_cast<size_t>(m_end - pos) < dlmLen
+                || stringV(pos, dlmLen) != m_dlm)) {
+            continue;
+        }
+        addField(fields, pos);
+        m_fieldBgn = pos + dlmLen;
+    }
+}
+
+//----------------------------------------------------------------------------//
+//************************ ColData::RowCounter Class *************************//
+//----------------------------------------------------------------------------//
+void RowCounter::count(const char* bgn, const char* end) {
+    while (bgn < end) {
+        const size_t len{
+            std::min(scanBlockBytes, static_cast<size_t>(end - bgn))
+        };
+        uint64_t validMask;
+        const ScanMasks masks{scanPartialBlock(bgn, len, '\n', validMask)};
+        uint64_t data{~masks.space & validMask};
+        uint64_t newlines{masks.newline & validMask};
+        while (newlines) {
+            const uint64_t rowMask{(newlines & (~newlines + 1)) - 1};
+            if (m_rowHasData || (data & rowMask)) { ++m_rowTotal; }
+            m_rowHasData = false;
+            data &= ~rowMask;
+            newlines &= newlines - 1;
+        }
+        if (data) { m_rowHasData = true; }
+        bgn += len;
+    }
+}
+
+/*
+ * Count the rows from the given beginning until the total reaches the given
+ * number of rows, and return the beginning of the row after the last one
+ * counted, or the end if there are not enough rows. No field is read.
+ */
+const char* RowCounter::skip(const char* bgn, const char* end,
+        const size_t rowTotal) {
+    if (m_rowTotal >= rowTotal) { return bgn; }
+    while (bgn < end) {
+        const size_t len{
+            std::min(scanBlockBytes, static_cast<size_t>(end - bgn))
+        };
+        uint64_t validMask;
+        const ScanMasks masks{scanPartialBlock(bgn, len, '\n', validMask)};
+        uint64_t data{~masks.space & validMask};
+        uint64_t newlines{masks.newline & validMask};
+        while (newlines) {
+            const uint64_t rowMask{(newlines & (~newlines + 1)) - 1};
+            if (m_rowHasData || (data & rowMask)) { ++m_rowTotal; }
+            m_rowHasData = false;
+            if (m_rowTotal == rowTotal) {
+                return bgn + __builtin_ctzll(newlines) + 1;
+            }
+            data &= ~rowMask;
+            newlines &= newlines - 1;
+        }
+        if (data) { m_rowHasData = true; }
+        bgn += len;
+    }
+    return end;
+}
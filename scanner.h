@@ -0,0 +1,81 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        scanner.h
+ * @brief       Find the rows and fields of the column data from bitmasks of
+ *              64-byte blocks, which are classified with SIMD instructions
+ *              where the processor supports them.
+ */
+
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include "namespaces.h"
+
+inline constexpr size_t scanBlockBytes = 64;
+
+//----------------------------------------------------------------------------//
+//************************ ColData::RowScanner Class *************************//
+//----------------------------------------------------------------------------//
+/*
+ * Scanner for the rows of data between two pointers. Each block is classified
+ * once into newline, delimiter and whitespace masks, and the field boundaries
+ * are read off the set bits, so no byte is inspected one at a time except to
+ * trim the whitespace around a delimited field. Blank rows are skipped. The
+ * fields are views into the data, so the data must outlive them.
+ */
+class ColData::RowScanner {
+  private:
+    const char* const   m_end;
+    const stringV       m_dlm;
+    const bool          m_spaced;
+    const char*         m_block;
+    const char*         m_next;
+    const char*         m_fieldBgn;
+    uint64_t            m_events{0};
+    uint64_t            m_newlines{0};
+    uint64_t            m_bounds{0};
+    uint64_t            m_prevSpace{1};
+    bool                m_inField{false};
+
+    RowScanner() = delete;
+    RowScanner(const RowScanner&) = delete;
+    RowScanner& operator=(const RowScanner&) = delete;
+
+    bool loadBlock();
+    void addField(vector<stringV>& fields, const char* fieldEnd) const;
+    bool nextSpacedRow(vector<stringV>& fields);
+    bool nextDelimitedRow(vector<stringV>& fields);
+
+  public:
+    explicit RowScanner(const char* bgn, const char* end, stringV dlm,
+        Delimitation dataDlmType);
+
+    // Read the fields of the next row; return false if there are no more rows.
+    bool nextRow(vector<stringV>& fields) {
+        fields.clear();
+        return m_spaced ? nextSpacedRow(fields) : nextDelimitedRow(fields);
+    }
+};
+
+//----------------------------------------------------------------------------//
+//************************ ColData::RowCounter Class *************************//
+//----------------------------------------------------------------------------//
+/*
+ * Counter for the rows of data that are fed to it in consecutive pieces; a row
+ * is counted if it has a byte that is not whitespace.
+ */
+class ColData::RowCounter {
+  private:
+    size_t  m_rowTotal{0};
+    bool    m_rowHasData{false};
+
+  public:
+    void count(const char* bgn, const char* end);
+    const char* skip(const char* bgn, const char* end, const size_t rowTotal);
+    size_t getRowTotal() const { return m_rowTotal + m_rowHasData; }
+};
+
+#endif
@@ -0,0 +1,517 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        stream.cpp
+ * @brief       Stream the column data through one-pass accumulators for the
+ *              calculations, the row and timestep ranges and the cycles,
+ *              without storing the columns.
+ */
+
+#include "namespaces.h"
+#include "colData.h"
+#include "stream.h"
+#include "tokenizer.h"
+#include "scanner.h"
+#include "errorMsgs.h"
+
+using namespace ColData;
+
+//----------------------------------------------------------------------------//
+//************************* ColData::StreamStats *****************************//
+//----------------------------------------------------------------------------//
+/*
+ * Add a value to the statistics. The sums are added in row order, as in the
+ * DoubleV summations; the sum of squares of the difference from the mean is
+ * updated with Welford's method, since the mean is not known in advance.
+ */
+void StreamStats::add(const double x) {
+    const double absX{std::abs(x)};
+    if (count == 0) {
+        min = max = x;
+        absMin = absMax = absX;
+    }
+    else {
+        if (min>x)          { min = x; }
+        if (max<x)          { max = x; }
+        if (absMin>absX)    { absMin = absX; }
+        if (absMax<absX)    { absMax = absX; }
+    }
+    ++count;
+    sum += x;
+    sumOfSquares += x*x;
+    sumOfCubes += x*x*x;
+    const double diff{x - mean};
+    mean += diff/static_cast<double>(count);
+    sumOfSquaresOfDifference += diff*(x - mean);
+}
+
+//----------------------------------------------------------------------------//
+//************************** ColData::StreamV Class **************************//
+//----------------------------------------------------------------------------//
+StreamV::StreamV(int colNo, const StreamStats& stats) :
+  m_id{s_total++}, m_colNo{colNo}, m_stats{stats} {
+    s_streamVSetP.push_back(this);
+}
+
+int StreamV::getId() const                      { return m_id; }
+int StreamV::getColNo() const                   { return m_colNo; }
+const StreamStats& StreamV::getStats() const    { return m_stats; }
+
+/*
+ * Return the result of the given calculation for the streamed rows.
+ */
+double StreamV::findCalc(const CmdArgs::CalcId calcId) const {
+    const double count{static_cast<double>(m_stats.count)};
+    switch (calcId) {
+        case CmdArgs::CalcId::findMin:      return m_stats.min;
+        case CmdArgs::CalcId::findMax:      return m_stats.max;
+        case CmdArgs::CalcId::findAbsMin:   return m_stats.absMin;
+        case CmdArgs::CalcId::findAbsMax:   return m_stats.absMax;
+        case CmdArgs::CalcId::findMean:     return m_stats.sum/count;
+        case CmdArgs::CalcId::findRMS:
+            return std::sqrt(m_stats.sumOfSquares/count);
+        case CmdArgs::CalcId::findFluctuationRMS:
+            return std::sqrt(m_stats.sumOfSquaresOfDifference/count);
+        case CmdArgs::CalcId::findCubicMean:
+            return std::cbrt(m_stats.sumOfCubes/count);
+        default:
+            throw logic_error(errorUnknown);
+    }
+}
+
+int StreamV::getTotal()                         { return s_total; }
+vector<StreamV*>& StreamV::getSetP()            { return s_streamVSetP; }
+void StreamV::clearSetP() {
+    for (StreamV* sVP : s_streamVSetP) { delete sVP; }
+    s_streamVSetP.clear();
+}
+StreamV* StreamV::getOnePFromCol(const int inputColNo) {
+    for (StreamV* sVP : s_streamVSetP) {
+        if (inputColNo == sVP->m_colNo) { return sVP; }
+    }
+    throw runtime_error(errorColNoAbsent);
+}
+
+//----------------------------------------------------------------------------//
+//************************ ColData::CycleStream Class ************************//
+//----------------------------------------------------------------------------//
+CycleStream::CycleStream(double center, double minAmplitude,
+        size_t minRowInterval, int cycles) :
+  m_center{center}, m_minAmplitude{minAmplitude},
+  m_minRowInterval{minRowInterval}, m_cycles{cycles},
+  m_cycleMax{center}, m_cycleMin{center} {}
+
+/*
+ * Set the first row of the range; the crossings are searched from the row
+ * before it, as in DoubleV::findCycles().
+ */
+void CycleStream::setRowBgn(const size_t rowBgn) {
+    m_rowNext = (rowBgn>0) ? rowBgn-1 : 0;
+    m_cycleData.rowInitial = rowBgn;
+    m_rowBgnSet = true;
+}
+void CycleStream::setRowEnd(const size_t rowEnd) { m_rowEnd = rowEnd; }
+
+/*
+ * Decide the crossing between row r and the next row; this is one iteration of
+ * the loops of DoubleV::findCycles(). Return false if r is past the last row.
+ */
+bool CycleStream::decide(const size_t r, const size_t rowLast) {
+    if (r > rowLast) { return false; }
+    const double mean{m_center}, x0{value(r)}, x1{value(r+1)};
+
+    if (!m_foundInitial) {
+        if ((signbit(x0 - mean) != signbit(x1 - mean))
+                || (x0 == mean && x0 != x1)) {
+            m_foundInitial = true;
+            if (std::abs(x0 - mean) < std::abs(x1 - mean)) {
+                m_cycleData.rowInitial = r;
+                if ((x0 != mean)
+                        || (x0 == mean && signbit(x0) != signbit(x1))) {
+                    m_crossings = -1;
+                }
+            }
+            else {
+                m_cycleData.rowInitial = r+1;
+            }
+        }
+        if (!m_foundInitial || m_cycleData.rowInitial > r) { return true; }
+    }
+    if (m_cycles >= 0 && m_cycleData.cycleCount >= m_cycles) { return false; }
+
+    m_cycleMin = (x0 < m_cycleMin) ? x0 : m_cycleMin;
+    m_cycleMax = (x0 > m_cycleMax) ? x0 : m_cycleMax;
+    // Before the first crossing, the distance is from the end of the range
+    const bool
+        isSignbitDiff{signbit(x0 - mean) != signbit(x1 - mean)},
+        isCycleMaxLarge{std::abs(m_cycleMax - mean) >= m_minAmplitude},
+        isCycleMinLarge{std::abs(m_cycleMin - mean) >= m_minAmplitude},
+        isCycleLong{m_crossed ? (r - m_rL) >= m_minRowInterval
+                              : (r < m_rowEnd || m_minRowInterval == 0)};
+    if (
+            (isSignbitDiff && (
+                (m_crossings == 0 && isCycleLong &&
+                    (isCycleMaxLarge || isCycleMinLarge)) ||
+                (m_crossings == 1 && isCycleLong &&
+                    (isCycleMaxLarge && isCycleMinLarge)) ||
+                (m_crossings <  0)
+            )) ||
+            (m_crossings == 1 && r+2 > rowLast && x1 == mean)
+       ) {
+        ++m_crossings;
+        m_rL = r;
+        m_crossed = true;
+        if (m_crossings == 2) {
+            ++m_cycleData.cycleCount;
+            m_crests.push_back(m_cycleMax);
+            m_troughs.push_back(m_cycleMin);
+            m_peaks.push_back(std::abs(m_cycleMax - mean));
+            m_peaks.push_back(std::abs(m_cycleMin - mean));
+            m_crossings = 0;
+            m_cycleMax = m_cycleMin = mean;
+            m_cycleData.rowFinal =
+                (std::abs(x0 - mean) < std::abs(x1 - mean)) ? r : (r+1);
+        }
+    }
+    return true;
+}
+
+/*
+ * Push the value of the next row. If a row is decided, set it and return true.
+ * Until the end of the data is known, the last row of the range is taken to be
+ * two rows ahead of the decided row, which is all that the decision depends on.
+ */
+bool CycleStream::push(const size_t row, const double x, size_t& decidedRow) {
+    m_values[row % (s_lag + 1)] = x;
+    m_rowTotal = row + 1;
+    if (!m_rowBgnSet || isDone() || row < m_rowNext + s_lag) { return false; }
+    if (!m_ended && !decide(m_rowNext, std::min(m_rowEnd, m_rowNext + 2))) {
+        m_ended = true;
+    }
+    decidedRow = m_rowNext++;
+    return true;
+}
+
+/*
+ * Decide the remaining rows one at a time after the last row has been pushed.
+ * Return false when there are none left.
+ */
+bool CycleStream::finish(size_t& decidedRow) {
+    if (!m_rowBgnSet || isDone() || m_rowNext >= m_rowTotal) { return false; }
+    if (!m_ended) {
+        if (m_rowNext + 1 >= m_rowTotal || !decide(m_rowNext,
+                std::min(m_rowEnd, m_rowTotal - 2))) {
+            m_ended = true;
+        }
+    }
+    decidedRow = m_rowNext++;
+    return true;
+}
+
+/*
+ * Check if no more rows are needed: no more crossings are decided and the final
+ * row of the last cycle, if any, has been decided.
+ */
+bool CycleStream::isDone() const {
+    return m_ended
+        && (m_cycleData.cycleCount == 0 || m_rowNext > m_cycleData.rowFinal);
+}
+bool CycleStream::hasInitial() const    { return m_foundInitial; }
+size_t CycleStream::getRowInitial() const { return m_cycleData.rowInitial; }
+size_t CycleStream::getRowFinal() const { return m_cycleData.rowFinal; }
+int CycleStream::getCycleCount() const  { return m_cycleData.cycleCount; }
+
+/*
+ * Return the cycle data; the final row is the given last row of the range if
+ * no cycle was completed.
+ */
+CycleData CycleStream::getCycleData(const size_t rowEnd) {
+    CycleData cData{calculateCycleData(m_crests, m_troughs, m_peaks)};
+    cData.cycleCount = m_cycleData.cycleCount;
+    cData.rowInitial = m_cycleData.rowInitial;
+    cData.rowFinal =
+        (m_cycleData.cycleCount > 0) ? m_cycleData.rowFinal : rowEnd;
+    return cData;
+}
+
+//----------------------------------------------------------------------------//
+//************************* ColData::DataStream Class ************************//
+//----------------------------------------------------------------------------//
+DataStream::State::State(const StreamQuery& streamQuery, int dataColTotal) :
+  query{streamQuery},
+  cycleStream{streamQuery.center, streamQuery.minAmplitude,
+      streamQuery.minRowInterval, streamQuery.cycles},
+  stats(dataColTotal), rowValues(4, vector<double>(dataColTotal)) {}
+
+/*
+ * Map the file, read the header and classify the columns from the first data
+ * row: the timestep column is the leftmost timestep column candidate whose
+ * first field is a non-negative integer. The column vectors are created
+ * without any data, for the names and numbers of the columns.
+ */
+DataStream::DataStream(const string& fileName, const string& dlm,
+        const LoadOptions& loadOptions) :
+  m_fileName{fileName}, m_mapP{new MappedFile(fileName)}, m_dlm{dlm},
+  m_followed{loadOptions.followed} {
+    cout << "File found. Program initiated." << flush;
+
+    stringV headerLine, dataLine;
+    tie(headerLine, dataLine, m_dataOffset) =
+        findMappedLines(m_mapP->getView(), dlm);
+    m_scanOffset = m_dataOffset;
+
+    string headerStr;
+    Delimitation headerDlmType;
+    tie(headerStr, headerDlmType) = parseHeaderLine(string{headerLine}, dlm);
+
+    vector<string> colNames;
+    tie(m_dataColTotal, colNames) =
+        identifyColumnHeaders(headerStr, dlm, headerDlmType);
+    m_dataDlmType = parseColumnData(dataLine, dlm);
+
+    const int timestepColNo{
+        findTimestepColFromRow(dataLine, dlm, m_dataDlmType, m_dataColTotal,
+            findTimestepColCandidates(m_dataColTotal, colNames))
+    };
+    if (timestepColNo >= 0) { IntV::insertColNoSet(timestepColNo); }
+    for (int c=0; c<m_dataColTotal; ++c) {
+        if (!IntV::getColNoSet().count(c)) {
+            DoubleV::insertColNoSet(c);
+        }
+    }
+    m_selectedCols = selectColumns(colNames, loadOptions);
+    createVectors(colNames, 0, m_selectedCols);
+    if (!IntV::getSetP().empty()) {
+        m_dataTimestepIVP = IntV::getOneP(0);
+    }
+}
+
+/*
+ * Stream the data rows once. The timestep column is verified and its range is
+ * found, the range of rows is resolved from the query, and the statistics of
+ * every selected data column are accumulated over that range, or over the
+ * cycles found in it if a cycle column is given. Only a few rows are held at a
+ * time.
+ */
+StreamResult DataStream::run(const StreamQuery& query) {
+    constexpr size_t unknown{numeric_limits<size_t>::max()};
+    m_stateP.reset(new State(query, m_dataColTotal));
+    State& state{*m_stateP};
+    state.rowBgn = query.rowBgnDefined ? query.rowBgn
+        : (query.timestepBgnDefined ? unknown : 0);
+    state.rowEnd = query.rowEndDefined ? query.rowEnd : unknown;
+    if (query.cycleColNo >= 0 && state.rowBgn != unknown) {
+        state.cycleStream.setRowBgn(state.rowBgn);
+    }
+    if (query.cycleColNo >= 0 && state.rowEnd != unknown) {
+        state.cycleStream.setRowEnd(state.rowEnd);
+    }
+
+    cout << "\rIn progress: Streaming column data..." << flush;
+    scan();
+    cout << '\r' << string(38, ' ') << "\n" << flush;
+    return getResult();
+}
+
+/*
+ * Map the followed file again if it has grown, and stream the lines that have
+ * been completed since the last scan. Return false if there are no new rows.
+ */
+bool DataStream::resume() {
+    std::error_code error;
+    const size_t fileSize{std::filesystem::file_size(m_fileName, error)};
+    if (error || fileSize < m_mapP->getSize()) {
+        throw runtime_error(errorFollowTruncated);
+    }
+    if (fileSize == m_mapP->getSize()) { return false; }
+    m_mapP.reset(new MappedFile(m_fileName));
+    const size_t rowTotal{m_stateP->row};
+    scan();
+    return m_stateP->row > rowTotal;
+}
+
+void DataStream::addRow(State& state, const size_t row) const {
+    const int tsCol{m_dataTimestepIVP ? m_dataTimestepIVP->getColNo() : -1};
+    const vector<double>& values{state.rowValues[row % 4]};
+    for (int c=0; c<m_dataColTotal; ++c) {
+        if (c != tsCol && m_selectedCols[c]) { state.stats[c].add(values[c]); }
+    }
+}
+
+/*
+ * Accumulate a row once its crossing has been decided, if it is in the cycles,
+ * and snapshot the accumulators at the final row of a completed cycle.
+ */
+void DataStream::decideRow(State& state, const size_t row) const {
+    const int tsCol{m_dataTimestepIVP ? m_dataTimestepIVP->getColNo() : -1};
+    const CycleStream& cycleStream{state.cycleStream};
+    const vector<double>& values{state.rowValues[row % 4]};
+    if (!cycleStream.hasInitial() || row < cycleStream.getRowInitial()) {
+        return;
+    }
+    if (row == cycleStream.getRowInitial()) {
+        if (tsCol >= 0) { state.result.timestepBgn = values[tsCol]; }
+        if (state.query.simTimeColNo >= 0) {
+            state.result.simTimeBgn = values[state.query.simTimeColNo];
+        }
+    }
+    addRow(state, row);
+    if (cycleStream.getCycleCount() > 0 && row == cycleStream.getRowFinal()) {
+        state.statsOfCycles = state.stats;
+        if (tsCol >= 0) { state.result.timestepEnd = values[tsCol]; }
+        if (state.query.simTimeColNo >= 0) {
+            state.result.simTimeEnd = values[state.query.simTimeColNo];
+        }
+    }
+}
+
+/*
+ * Stream the rows from the end of the last scan into the accumulators, up to
+ * the end of the file, or up to its last complete line if it is followed.
+ */
+void DataStream::scan() {
+    constexpr size_t unknown{numeric_limits<size_t>::max()};
+    State& state{*m_stateP};
+    const StreamQuery& query{state.query};
+    const int tsCol{m_dataTimestepIVP ? m_dataTimestepIVP->getColNo() : -1};
+    const bool cycled{query.cycleColNo >= 0};
+
+    size_t scanEnd{m_mapP->getSize()};
+    if (m_followed) {
+        const size_t eol{m_mapP->getView().rfind('\n')};
+        scanEnd = (eol == stringV::npos || eol < m_scanOffset) ? m_scanOffset
+            : eol + 1;
+    }
+    RowScanner scanner{m_mapP->getData() + m_scanOffset,
+        m_mapP->getData() + scanEnd, m_dlm, m_dataDlmType};
+    m_scanOffset = scanEnd;
+    vector<stringV> fields;
+    vector<FixedFormat> formats;
+    size_t& row{state.row};
+    size_t decidedRow;
+
+    for (; scanner.nextRow(fields); ++row) {
+        if (fields.size() < static_cast<size_t>(m_dataColTotal)) {
+            throw runtime_error(errorDlmFormatIncorrect);
+        }
+        if (formats.empty()) {
+            for (int c=0; c<m_dataColTotal; ++c) {
+                formats.emplace_back(fields[c]);
+            }
+        }
+        vector<double>& values{state.rowValues[row % 4]};
+        for (int c=0; c<m_dataColTotal; ++c) {
+            if (c == tsCol) {
+                int ts;
+                if (!FieldTokenizer::isDigits(fields[c])
+                        || !FieldTokenizer::toNumber(fields[c], ts)) {
+                    throw runtime_error(errorStreamTimestepInvalid);
+                }
+                if (row == 0)               { state.tsFirst = ts; }
+                else if (ts <= state.tsPrev) { state.tsConsistent = false; }
+                state.tsPrev = ts;
+                values[c] = ts;
+            }
+            else if (m_selectedCols[c]
+                    && !formats[c].toNumber(fields[c], values[c])
+                    && !FieldTokenizer::toNumber(fields[c], values[c])) {
+                throw runtime_error(errorDataFormatIncorrect);
+            }
+        }
+        if (tsCol >= 0) {
+            const size_t ts{static_cast<size_t>(state.tsPrev)};
+            if (state.rowBgn == unknown && ts == query.timestepBgn) {
+                state.rowBgn = row;
+                if (cycled) { state.cycleStream.setRowBgn(state.rowBgn); }
+            }
+            if (state.rowEnd == unknown && query.timestepEndDefined
+                    && ts == query.timestepEnd) {
+                state.rowEnd = row;
+                if (cycled) { state.cycleStream.setRowEnd(state.rowEnd); }
+            }
+        }
+        if (row == state.rowEnd && tsCol >= 0) {
+            state.tsAtRowEnd = values[tsCol];
+        }
+
+        if (cycled) {
+            if (state.cycleStream.push(row, values[query.cycleColNo],
+                    decidedRow)) {
+                decideRow(state, decidedRow);
+            }
+        }
+        else if (row >= state.rowBgn && row <= state.rowEnd) {
+            if (row == state.rowBgn && tsCol >= 0) {
+                state.result.timestepBgn = values[tsCol];
+            }
+            addRow(state, row);
+        }
+    }
+}
+
+/*
+ * Return the result for the rows streamed so far. The cycles are finished on a
+ * copy of the state, which is left to go on with the rows appended later. The
+ * streamed column vectors are created again for the result.
+ */
+StreamResult DataStream::getResult() const {
+    constexpr size_t unknown{numeric_limits<size_t>::max()};
+    State state{*m_stateP};
+    const StreamQuery& query{state.query};
+    const int tsCol{m_dataTimestepIVP ? m_dataTimestepIVP->getColNo() : -1};
+    const bool cycled{query.cycleColNo >= 0};
+    const size_t row{state.row};
+    size_t decidedRow;
+    while (cycled && state.cycleStream.finish(decidedRow)) {
+        decideRow(state, decidedRow);
+    }
+
+    StreamResult& result{state.result};
+    result.dataRowTotal = row;
+    if (result.dataRowTotal == 0) {
+        throw runtime_error(errorDlmFormatIncorrect);
+    }
+    if (tsCol >= 0 && state.tsConsistent && state.tsFirst >= 0) {
+        result.timestepRange = {true, static_cast<size_t>(state.tsFirst),
+            static_cast<size_t>(state.tsPrev)};
+    }
+    else {
+        result.timestepRange = {false, 0, 0};
+    }
+    if (state.rowEnd == unknown && !query.timestepEndDefined) {
+        state.rowEnd = row - 1;
+        state.tsAtRowEnd = state.tsPrev;
+    }
+    result.rowRangeFound = (state.rowBgn < row && state.rowEnd < row
+        && state.rowBgn <= state.rowEnd);
+    result.rowBgn = state.rowBgn;
+    result.rowEnd = state.rowEnd;
+    if (cycled) {
+        result.cycleInitialFound = state.cycleStream.hasInitial();
+        result.cycleData = state.cycleStream.getCycleData(state.rowEnd);
+        result.rowBgn = result.cycleData.rowInitial;
+        result.rowEnd = result.cycleData.rowFinal;
+        if (result.cycleData.cycleCount == 0) {
+            result.timestepEnd = state.tsAtRowEnd;
+        }
+        state.stats.swap(state.statsOfCycles);
+        state.stats.resize(m_dataColTotal);
+    }
+    else {
+        result.timestepEnd = state.tsAtRowEnd;
+    }
+    StreamV::clearSetP();
+    for (int colNo : DoubleV::getColNoSet()) {
+        new StreamV(colNo, state.stats[colNo]);
+    }
+    return result;
+}
+
+Delimitation DataStream::getDataDlmType() const { return m_dataDlmType; }
+int DataStream::getDataColTotal() const         { return m_dataColTotal; }
+IntV* DataStream::getDataTimestepIVP() const    { return m_dataTimestepIVP; }
+LoadStats DataStream::getLoadStats() const {
+    return {m_mapP->getSize(), m_mapP->getSize()};
+}
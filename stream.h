@@ -0,0 +1,176 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        stream.h
+ * @brief       Stream the column data through one-pass accumulators for the
+ *              calculations, the row and timestep ranges and the cycles,
+ *              without storing the columns.
+ */
+
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <memory>
+
+#include "namespaces.h"
+#include "fileMap.h"
+#include "errorMsgs.h"
+
+//----------------------------------------------------------------------------//
+//************************** ColData::StreamV Class **************************//
+//----------------------------------------------------------------------------//
+/*
+ * Streamed column class, which keeps the accumulated statistics of the rows of
+ * a data column that were selected while streaming, instead of its data.
+ */
+class ColData::StreamV {
+  private:
+    const int                       m_id;
+    const int                       m_colNo;
+    const StreamStats               m_stats;
+    inline static int               s_total{};
+    inline static vector<StreamV*>  s_streamVSetP{};
+
+    StreamV() = delete;
+    StreamV(const StreamV&) = delete;
+    StreamV& operator=(const StreamV&) = delete;
+
+  public:
+    explicit StreamV(int colNo, const StreamStats& stats);
+
+    int getId() const;
+    int getColNo() const;
+    const StreamStats& getStats() const;
+    double findCalc(const CmdArgs::CalcId calcId) const;
+
+    static int getTotal();
+    static vector<StreamV*>& getSetP();
+    static void clearSetP();
+    static StreamV* getOnePFromCol(const int inputColNo);
+};
+
+//----------------------------------------------------------------------------//
+//************************ ColData::CycleStream Class ************************//
+//----------------------------------------------------------------------------//
+/*
+ * One-pass form of DoubleV::findCycles() and DoubleV::findCyclesFirst(). The
+ * values of the cycle column are pushed row by row, and each crossing of the
+ * center is decided three rows late, which is when it is known whether the
+ * crossing is one of the last two of the range. The caller accumulates a row
+ * once its crossing has been decided, and snapshots its accumulators when the
+ * row is the final row of a completed cycle. A copy can be finished while the
+ * original goes on with the rows that are appended later.
+ */
+class ColData::CycleStream {
+  private:
+    inline static constexpr size_t s_lag{3};
+    const double    m_center;
+    const double    m_minAmplitude;
+    const size_t    m_minRowInterval;
+    const int       m_cycles;           // -1 for all the cycles
+    size_t          m_rowEnd{numeric_limits<size_t>::max()};
+    size_t          m_rowNext{0};       // next row to be decided
+    size_t          m_rowTotal{0};      // rows pushed so far
+    bool            m_rowBgnSet{false};
+    bool            m_ended{false};     // no more crossings are decided
+    bool            m_foundInitial{false};
+    bool            m_crossed{false};   // a crossing has been counted
+    int             m_crossings{0};
+    size_t          m_rL{0};
+    double          m_cycleMax;
+    double          m_cycleMin;
+    double          m_values[s_lag + 1]{};
+    vector<double>  m_crests, m_troughs, m_peaks;
+    CycleData       m_cycleData{};
+
+    CycleStream() = delete;
+    CycleStream& operator=(const CycleStream&) = delete;
+
+    double value(const size_t row) const {
+        return m_values[row % (s_lag + 1)];
+    }
+    bool decide(const size_t r, const size_t rowLast);
+
+  public:
+    explicit CycleStream(double center, double minAmplitude,
+        size_t minRowInterval, int cycles);
+
+    void setRowBgn(const size_t rowBgn);
+    void setRowEnd(const size_t rowEnd);
+    bool push(const size_t row, const double x, size_t& decidedRow);
+    bool finish(size_t& decidedRow);
+
+    bool isDone() const;
+    bool hasInitial() const;
+    size_t getRowInitial() const;
+    size_t getRowFinal() const;
+    int getCycleCount() const;
+    CycleData getCycleData(const size_t rowEnd);
+};
+
+//----------------------------------------------------------------------------//
+//************************* ColData::DataStream Class ************************//
+//----------------------------------------------------------------------------//
+/*
+ * Memory-mapped input file whose header is read and whose columns are
+ * classified from the first data row when it is opened, so that the column
+ * options can be resolved before the data is streamed through run(). The
+ * timestep column is verified while streaming. The state of the accumulators
+ * is kept, so that a followed file can be mapped again when it grows and only
+ * the appended lines are streamed by resume(); a followed file is streamed up
+ * to its last complete line.
+ */
+class ColData::DataStream {
+  private:
+    struct State {
+        StreamQuery             query;
+        size_t                  row{0};         // rows streamed so far
+        size_t                  rowBgn, rowEnd;
+        CycleStream             cycleStream;
+        bool                    tsConsistent{true};
+        int                     tsFirst{0}, tsPrev{0};
+        size_t                  tsAtRowEnd{0};
+        vector<StreamStats>     stats, statsOfCycles;
+        vector<vector<double>>  rowValues;      // of the last four rows
+        StreamResult            result{};
+
+        explicit State(const StreamQuery& streamQuery, int dataColTotal);
+    };
+
+    const string                        m_fileName;
+    std::unique_ptr<const MappedFile>   m_mapP;
+    const string                        m_dlm;
+    const bool                          m_followed;
+    Delimitation        m_dataDlmType{Delimitation::undefined};
+    int                 m_dataColTotal{0};
+    size_t              m_dataOffset{0};
+    size_t              m_scanOffset{0};        // end of the streamed lines
+    IntV*               m_dataTimestepIVP{nullptr};
+    vector<bool>        m_selectedCols{};
+    std::unique_ptr<State>  m_stateP{};
+
+    DataStream() = delete;
+    DataStream(const DataStream&) = delete;
+    DataStream& operator=(const DataStream&) = delete;
+
+    void scan();
+    void addRow(State& state, const size_t row) const;
+    void decideRow(State& state, const size_t row) const;
+
+  public:
+    explicit DataStream(const string& fileName, const string& dlm,
+        const LoadOptions& loadOptions);
+
+    StreamResult run(const StreamQuery& query);
+    bool resume();
+    StreamResult getResult() const;
+
+    Delimitation getDataDlmType() const;
+    int getDataColTotal() const;
+    IntV* getDataTimestepIVP() const;
+    LoadStats getLoadStats() const;
+};
+
+#endif
@@ -0,0 +1,192 @@
+/**
+ * @version     ColDataUtil 1.5
+ * @author      Syed Ahmad Raza (git@ahmads.org)
+ * @copyright   GPLv3+: GNU Public License version 3 or later
+ *
+ * @file        tokenizer.h
+ * @brief       Split data lines into fields and convert them to numbers
+ *              without allocating any memory, with a fast path for the
+ *              fixed scientific format written by solvers.
+ */
+
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <charconv>
+#include <cstring>
+
+#include "namespaces.h"
+
+//----------------------------------------------------------------------------//
+//********************** ColData::FieldTokenizer Class ***********************//
+//----------------------------------------------------------------------------//
+/*
+ * Tokenizer for the fields of one data line. The fields are views into the
+ * line, so the line must outlive them. Whitespace separates the fields of
+ * spaced data; the delimiter separates them otherwise, and any whitespace
+ * around a delimited field is dropped.
+ */
+class ColData::FieldTokenizer {
+  private:
+    const stringV   m_line;
+    const stringV   m_dlm;
+    const bool      m_spaced;
+    size_t          m_pos{0};
+
+    FieldTokenizer() = delete;
+    FieldTokenizer(const FieldTokenizer&) = delete;
+    FieldTokenizer& operator=(const FieldTokenizer&) = delete;
+
+  public:
+    explicit FieldTokenizer(stringV line, stringV dlm,
+            Delimitation dataDlmType) :
+      m_line{line}, m_dlm{dlm},
+      m_spaced{dataDlmType == Delimitation::spaced} {}
+
+    static bool isSpace(const char c) {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    // Read the next field; return false if there are no more fields.
+    bool next(stringV& field) {
+        const size_t len{m_line.length()};
+        if (m_spaced) {
+            while (m_pos < len && isSpace(m_line[m_pos])) { ++m_pos; }
+            if (m_pos == len) { return false; }
+            size_t fieldEnd{m_pos};
+            while (fieldEnd < len && !isSpace(m_line[fieldEnd])) { ++fieldEnd; }
+            field = m_line.substr(m_pos, fieldEnd - m_pos);
+            m_pos = fieldEnd;
+            return true;
+        }
+        if (m_pos > len) { return false; }
+        size_t fieldEnd{m_line.find(m_dlm, m_pos)};
+        if (fieldEnd == stringV::npos) { fieldEnd = len; }
+        size_t fieldBgn{m_pos};
+        m_pos = fieldEnd + m_dlm.length();
+        while (fieldBgn < fieldEnd && isSpace(m_line[fieldBgn])) { ++fieldBgn; }
+        while (fieldEnd > fieldBgn && isSpace(m_line[fieldEnd-1])) { --fieldEnd; }
+        field = m_line.substr(fieldBgn, fieldEnd - fieldBgn);
+        return true;
+    }
+
+    // Convert a whole field to a number; return false if it is not one.
+    template<typename T>
+    static bool toNumber(stringV field, T& value) {
+        if (!field.empty() && field[0] == '+') { field.remove_prefix(1); }
+        const char* fieldEnd{field.data() + field.length()};
+        const std::from_chars_result result{
+            std::from_chars(field.data(), fieldEnd, value)
+        };
+        return result.ec == std::errc() && result.ptr == fieldEnd;
+    }
+
+    // Check if a field is a non-negative integer.
+    static bool isDigits(stringV field) {
+        return all_of(field.begin(), field.end(),
+            [](char c) { return c >= '0' && c <= '9'; });
+    }
+};
+
+//----------------------------------------------------------------------------//
+//*********************** ColData::FixedFormat Class *************************//
+//----------------------------------------------------------------------------//
+/*
+ * Fixed scientific format of the numbers written by solvers, such as
+ * -1.23456789e-03: an optional minus sign, one digit, a point, a fixed number
+ * of fraction digits, and an exponent with a sign and a fixed number of
+ * digits. The format of a column is found from its field in the first row that
+ * is parsed, and the fields of that shape are then read at fixed positions,
+ * eight digits at a time. The digits fit in the mantissa of a double and the
+ * power of ten is exact, so the one multiplication or division is rounded
+ * correctly, as by from_chars. A field of any other shape, or with a power of
+ * ten that is not exact, is left to FieldTokenizer::toNumber().
+ */
+class ColData::FixedFormat {
+  private:
+    inline static constexpr double s_powers[23]{
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    uint8_t m_fractionDigits{0};    // none if the format was not found
+    uint8_t m_exponentDigits{0};
+
+    static bool isDigit(const char c) { return c >= '0' && c <= '9'; }
+
+    // Add the given number of digits to the value; return false at a byte that
+    // is not a digit.
+    static bool readDigits(const char* p, size_t n, uint64_t& value) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        for (; n >= 8; p += 8, n -= 8) {
+            uint64_t bytes;
+            std::memcpy(&bytes, p, 8);
+            if ((((bytes & 0xF0F0F0F0F0F0F0F0)
+                    | (((bytes + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0)
+                        >> 4)) != 0x3333333333333333)) {
+                return false;
+            }
+            bytes -= 0x3030303030303030;
+            bytes = bytes*10 + (bytes >> 8);
+            bytes = ((bytes & 0x000000FF000000FF)*0x000F424000000064
+                + ((bytes >> 16) & 0x000000FF000000FF)*0x0000271000000001)
+                >> 32;
+            value = value*100000000 + static_cast<uint32_t>(bytes);
+        }
+#endif
+        for (; n > 0; ++p, --n) {
+            if (!isDigit(*p)) { return false; }
+            value = value*10 + (*p - '0');
+        }
+        return true;
+    }
+
+  public:
+    FixedFormat() = default;
+
+    // Find the format from a field; it is not found if the field has another
+    // shape or too many digits to be read exactly.
+    explicit FixedFormat(stringV field) {
+        if (!field.empty() && field[0] == '-') { field.remove_prefix(1); }
+        const size_t ePos{field.find_first_of("eE")};
+        if (ePos == stringV::npos || ePos < 3 || ePos > 16
+                || field.length() < ePos + 3 || field.length() > ePos + 5
+                || !isDigit(field[0]) || field[1] != '.'
+                || (field[ePos+1] != '-' && field[ePos+1] != '+')) {
+            return;
+        }
+        for (size_t i=2; i<field.length(); ++i) {
+            if (i != ePos && i != ePos+1 && !isDigit(field[i])) { return; }
+        }
+        m_fractionDigits = static_cast<uint8_t>(ePos - 2);
+        m_exponentDigits = static_cast<uint8_t>(field.length() - ePos - 2);
+    }
+
+    // Convert a field of this format to a number; return false if the field
+    // is not of this format or cannot be converted exactly by it.
+    bool toNumber(stringV field, double& value) const {
+        const bool negative{!field.empty() && field[0] == '-'};
+        if (m_fractionDigits == 0 || field.length() != negative + 4u
+                + m_fractionDigits + m_exponentDigits) {
+            return false;
+        }
+        const char* p{field.data() + negative};
+        const char* e{p + 2 + m_fractionDigits};
+        uint64_t mantissa{0}, exponent{0};
+        if (p[1] != '.' || (e[0] != 'e' && e[0] != 'E')
+                || (e[1] != '-' && e[1] != '+')
+                || !readDigits(p, 1, mantissa)
+                || !readDigits(p + 2, m_fractionDigits, mantissa)
+                || !readDigits(e + 2, m_exponentDigits, exponent)) {
+            return false;
+        }
+        const int64_t power{(e[1] == '-' ? -static_cast<int64_t>(exponent)
+            : static_cast<int64_t>(exponent)) - m_fractionDigits};
+        if (power < -22 || power > 22) { return false; }
+        const double x{static_cast<double>(mantissa)};
+        value = (power < 0) ? x/s_powers[-power] : x*s_powers[power];
+        if (negative) { value = -value; }
+        return true;
+    }
+};
+
+#endif